@@ -0,0 +1,109 @@
+#include "tpms_alert.h"
+
+#define TAG "TPMSAlert"
+
+// Per-sensor re-arm time: once fired, a sensor stays quiet this long
+#define TPMS_ALERT_COOLDOWN_MS 60000
+
+// Tracked sensors for cooldown; a car has four wheels, a shop bay rarely
+// sees more live at once. Oldest entry is recycled when full
+#define TPMS_ALERT_COOLDOWN_SLOTS 8
+
+typedef struct {
+    uint32_t id;
+    uint32_t tick;
+} TPMSAlertCooldownSlot;
+
+struct TPMSAlert {
+    int16_t pressure_floor_cb;
+    int16_t delta_drop_cb;
+    TPMSAlertCooldownSlot cooldown[TPMS_ALERT_COOLDOWN_SLOTS];
+};
+
+TPMSAlert* tpms_alert_alloc(void) {
+    TPMSAlert* instance = malloc(sizeof(TPMSAlert));
+    memset(instance, 0, sizeof(TPMSAlert));
+    return instance;
+}
+
+void tpms_alert_free(TPMSAlert* instance) {
+    furi_assert(instance);
+    free(instance);
+}
+
+void tpms_alert_set_pressure_floor(TPMSAlert* instance, int16_t pressure_floor_cb) {
+    furi_assert(instance);
+    instance->pressure_floor_cb = pressure_floor_cb;
+}
+
+int16_t tpms_alert_get_pressure_floor(TPMSAlert* instance) {
+    furi_assert(instance);
+    return instance->pressure_floor_cb;
+}
+
+void tpms_alert_set_delta_drop(TPMSAlert* instance, int16_t delta_drop_cb) {
+    furi_assert(instance);
+    instance->delta_drop_cb = delta_drop_cb;
+}
+
+int16_t tpms_alert_get_delta_drop(TPMSAlert* instance) {
+    furi_assert(instance);
+    return instance->delta_drop_cb;
+}
+
+static bool tpms_alert_cooldown_passed(TPMSAlert* instance, uint32_t id) {
+    uint32_t now = furi_get_tick();
+    size_t oldest = 0;
+
+    for(size_t i = 0; i < TPMS_ALERT_COOLDOWN_SLOTS; i++) {
+        TPMSAlertCooldownSlot* slot = &instance->cooldown[i];
+        if(slot->id == id) {
+            if((now - slot->tick) < TPMS_ALERT_COOLDOWN_MS) return false;
+            slot->tick = now;
+            return true;
+        }
+        if(slot->tick < instance->cooldown[oldest].tick) oldest = i;
+    }
+
+    instance->cooldown[oldest].id = id;
+    instance->cooldown[oldest].tick = now;
+    return true;
+}
+
+TPMSAlertEvent tpms_alert_check(
+    TPMSAlert* instance,
+    const TPMSHistoryRecord* record,
+    const TPMSTrendSample* trend,
+    uint8_t trend_count) {
+    furi_assert(instance);
+    furi_assert(record);
+
+    if(!instance->pressure_floor_cb && !instance->delta_drop_cb) return TPMSAlertEventNone;
+
+    int16_t pressure_cb = (int16_t)(record->pressure_mb / 10);
+    TPMSAlertEvent event = TPMSAlertEventNone;
+
+    if(instance->pressure_floor_cb && (pressure_cb < instance->pressure_floor_cb)) {
+        event = TPMSAlertEventLowPressure;
+    } else if(instance->delta_drop_cb && trend_count) {
+        // Leak: drop against the high-water mark of the trend ring
+        int16_t max_cb = trend[0].pressure_cb;
+        for(uint8_t i = 1; i < trend_count; i++) {
+            if(trend[i].pressure_cb > max_cb) max_cb = trend[i].pressure_cb;
+        }
+        if((max_cb - pressure_cb) >= instance->delta_drop_cb) {
+            event = TPMSAlertEventLeak;
+        }
+    }
+
+    if(event == TPMSAlertEventNone) return event;
+    if(!tpms_alert_cooldown_passed(instance, record->id)) return TPMSAlertEventNone;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: id %lX at %d cb",
+        (event == TPMSAlertEventLowPressure) ? "low pressure" : "leak",
+        record->id,
+        pressure_cb);
+    return event;
+}
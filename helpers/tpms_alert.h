@@ -0,0 +1,68 @@
+#pragma once
+
+#include <furi.h>
+#include "../tpms_history.h"
+
+typedef struct TPMSAlert TPMSAlert;
+
+typedef enum {
+    TPMSAlertEventNone,
+    TPMSAlertEventLowPressure, ///< pressure under the configured floor
+    TPMSAlertEventLeak, ///< pressure dropped by the configured delta within the trend ring
+} TPMSAlertEvent;
+
+/** Allocate TPMSAlert with both thresholds disabled
+ *
+ * @return TPMSAlert*
+ */
+TPMSAlert* tpms_alert_alloc(void);
+
+/** Free TPMSAlert
+ *
+ * @param instance - TPMSAlert instance
+ */
+void tpms_alert_free(TPMSAlert* instance);
+
+/** Set the absolute pressure floor, 0 disables
+ *
+ * @param instance - TPMSAlert instance
+ * @param pressure_floor_cb - floor in centibar
+ */
+void tpms_alert_set_pressure_floor(TPMSAlert* instance, int16_t pressure_floor_cb);
+
+/** Get the absolute pressure floor, centibar, 0 when disabled
+ *
+ * @param instance - TPMSAlert instance
+ * @return floor in centibar
+ */
+int16_t tpms_alert_get_pressure_floor(TPMSAlert* instance);
+
+/** Set the delta-drop threshold, 0 disables
+ *
+ * @param instance - TPMSAlert instance
+ * @param delta_drop_cb - drop in centibar that counts as a leak
+ */
+void tpms_alert_set_delta_drop(TPMSAlert* instance, int16_t delta_drop_cb);
+
+/** Get the delta-drop threshold, centibar, 0 when disabled
+ *
+ * @param instance - TPMSAlert instance
+ * @return drop in centibar
+ */
+int16_t tpms_alert_get_delta_drop(TPMSAlert* instance);
+
+/** Evaluate the thresholds against one updated record, a couple of
+ *  integer comparisons plus a per-sensor cooldown so the same tire does
+ *  not retrigger on every retransmission
+ *
+ * @param instance - TPMSAlert instance
+ * @param record - the just-updated history record
+ * @param trend - the sensor's trend ring, oldest first
+ * @param trend_count - trend sample count
+ * @return event to notify, TPMSAlertEventNone when nothing fired
+ */
+TPMSAlertEvent tpms_alert_check(
+    TPMSAlert* instance,
+    const TPMSHistoryRecord* record,
+    const TPMSTrendSample* trend,
+    uint8_t trend_count);
@@ -0,0 +1,200 @@
+#include "tpms_edge_batcher.h"
+#include "../protocols/protocol_items.h"
+
+#define TAG "TPMSEdgeBatcher"
+
+// Ring capacity in edges, power of two. 4096 edges is roughly half a
+// second of dense burst traffic, enough to ride out a UI redraw
+#define TPMS_EDGE_RING_SIZE 4096
+#define TPMS_EDGE_RING_MASK (TPMS_EDGE_RING_SIZE - 1)
+
+// Edges are packed as level:1 | duration:31
+#define TPMS_EDGE_LEVEL_BIT 0x80000000UL
+
+#define TPMS_EDGE_FLAG_DATA (1 << 0)
+#define TPMS_EDGE_FLAG_EXIT (1 << 1)
+
+typedef struct {
+    uint32_t* ring;
+    volatile uint32_t head; // written by the worker thread only
+    volatile uint32_t tail; // written by the decode thread only
+    volatile bool need_reset;
+    SubGhzReceiver* receiver;
+    const SubGhzDevice* squelch_device;
+    TPMSEdgeBatcherTeeCallback tee;
+    void* tee_context;
+    TPMSEdgeBatcher* owner;
+} TPMSEdgeBatcherSource;
+
+struct TPMSEdgeBatcher {
+    TPMSEdgeBatcherSource sources[TPMS_EDGE_SOURCE_COUNT];
+    uint32_t lost;
+    volatile bool squelch_enabled;
+    float squelch_floor;
+    FuriThread* thread;
+    bool running;
+};
+
+void tpms_edge_batcher_pair_callback(void* context, bool level, uint32_t duration) {
+    furi_assert(context);
+    TPMSEdgeBatcherSource* source = context;
+
+    // Tee sees every edge, even ones a full ring forces us to drop
+    if(source->tee) source->tee(source->tee_context, level, duration);
+
+    uint32_t head = source->head;
+    uint32_t next = (head + 1) & TPMS_EDGE_RING_MASK;
+    if(next == source->tail) {
+        // Ring full: drop this edge, decoders get resynced at drain
+        source->owner->lost++;
+        source->need_reset = true;
+        return;
+    }
+    source->ring[head] =
+        (duration & ~TPMS_EDGE_LEVEL_BIT) | (level ? TPMS_EDGE_LEVEL_BIT : 0);
+    source->head = next;
+
+    // Wake the decode thread only on empty->nonempty transition, the
+    // per-edge cost stays a store plus one compare
+    if(head == source->tail) {
+        furi_thread_flags_set(furi_thread_get_id(source->owner->thread), TPMS_EDGE_FLAG_DATA);
+    }
+}
+
+void tpms_edge_batcher_overrun_callback(void* context) {
+    furi_assert(context);
+    TPMSEdgeBatcherSource* source = context;
+    source->owner->lost++;
+    source->need_reset = true;
+}
+
+uint32_t tpms_edge_batcher_get_lost(TPMSEdgeBatcher* instance) {
+    furi_assert(instance);
+    return instance->lost;
+}
+
+static int32_t tpms_edge_batcher_worker(void* context) {
+    TPMSEdgeBatcher* instance = context;
+
+    while(true) {
+        uint32_t flags =
+            furi_thread_flags_wait(TPMS_EDGE_FLAG_DATA | TPMS_EDGE_FLAG_EXIT, FuriFlagWaitAny, 10);
+        if((flags != (uint32_t)FuriFlagErrorTimeout) && (flags & TPMS_EDGE_FLAG_EXIT)) break;
+
+        for(size_t i = 0; i < TPMS_EDGE_SOURCE_COUNT; i++) {
+            TPMSEdgeBatcherSource* source = &instance->sources[i];
+            if(!source->receiver) continue;
+
+            // Squelch: with nothing buffered the radio may be idle, so
+            // only touch RSSI when edges actually arrived
+            if(instance->squelch_enabled && source->squelch_device &&
+               source->tail != source->head) {
+                if(subghz_devices_get_rssi(source->squelch_device) < instance->squelch_floor) {
+                    // Below the floor it is noise: discard the batch
+                    // wholesale, decoders resync when the gate reopens
+                    source->tail = source->head;
+                    source->need_reset = true;
+                    continue;
+                }
+            }
+
+            if(source->need_reset) {
+                source->need_reset = false;
+                subghz_receiver_reset(source->receiver);
+            }
+
+            // Drain everything currently buffered in one block
+            uint32_t tail = source->tail;
+            while(tail != source->head) {
+                uint32_t packed = source->ring[tail];
+                tail = (tail + 1) & TPMS_EDGE_RING_MASK;
+                source->tail = tail;
+                tpms_protocol_front_end_feed(
+                    source->receiver,
+                    (packed & TPMS_EDGE_LEVEL_BIT) != 0,
+                    packed & ~TPMS_EDGE_LEVEL_BIT);
+            }
+        }
+    }
+    return 0;
+}
+
+void tpms_edge_batcher_set_source_receiver(
+    TPMSEdgeBatcher* instance,
+    uint8_t source,
+    SubGhzReceiver* receiver) {
+    furi_assert(instance);
+    furi_assert(source < TPMS_EDGE_SOURCE_COUNT);
+    if(!instance->sources[source].ring) {
+        instance->sources[source].ring = malloc(TPMS_EDGE_RING_SIZE * sizeof(uint32_t));
+    }
+    instance->sources[source].head = 0;
+    instance->sources[source].tail = 0;
+    instance->sources[source].need_reset = false;
+    instance->sources[source].receiver = receiver;
+    instance->sources[source].owner = instance;
+}
+
+void tpms_edge_batcher_set_tee(
+    TPMSEdgeBatcher* instance,
+    uint8_t source,
+    TPMSEdgeBatcherTeeCallback callback,
+    void* context) {
+    furi_assert(instance);
+    furi_assert(source < TPMS_EDGE_SOURCE_COUNT);
+    instance->sources[source].tee_context = context;
+    instance->sources[source].tee = callback;
+}
+
+void tpms_edge_batcher_set_squelch_device(
+    TPMSEdgeBatcher* instance,
+    uint8_t source,
+    const SubGhzDevice* device) {
+    furi_assert(instance);
+    furi_assert(source < TPMS_EDGE_SOURCE_COUNT);
+    instance->sources[source].squelch_device = device;
+}
+
+void tpms_edge_batcher_set_squelch(TPMSEdgeBatcher* instance, bool enabled, float floor) {
+    furi_assert(instance);
+    instance->squelch_floor = floor;
+    instance->squelch_enabled = enabled;
+}
+
+void* tpms_edge_batcher_get_source(TPMSEdgeBatcher* instance, uint8_t source) {
+    furi_assert(instance);
+    furi_assert(source < TPMS_EDGE_SOURCE_COUNT);
+    return &instance->sources[source];
+}
+
+TPMSEdgeBatcher* tpms_edge_batcher_alloc(SubGhzReceiver* receiver) {
+    furi_assert(receiver);
+    TPMSEdgeBatcher* instance = malloc(sizeof(TPMSEdgeBatcher));
+    memset(instance, 0, sizeof(TPMSEdgeBatcher));
+    // This thread runs the whole decode fan-out down to the receive
+    // callback (menu-string printf, session log, stream push), the work
+    // the 2048-byte SubGhzWorker stack used to carry; size it the same
+    instance->thread =
+        furi_thread_alloc_ex("TPMSEdgeBatcher", 2048, tpms_edge_batcher_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityHigh);
+
+    tpms_edge_batcher_set_source_receiver(instance, 0, receiver);
+
+    furi_thread_start(instance->thread);
+    instance->running = true;
+    return instance;
+}
+
+void tpms_edge_batcher_free(TPMSEdgeBatcher* instance) {
+    furi_assert(instance);
+    if(instance->running) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_EDGE_FLAG_EXIT);
+        furi_thread_join(instance->thread);
+        instance->running = false;
+    }
+    furi_thread_free(instance->thread);
+    for(size_t i = 0; i < TPMS_EDGE_SOURCE_COUNT; i++) {
+        free(instance->sources[i].ring);
+    }
+    free(instance);
+}
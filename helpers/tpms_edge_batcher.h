@@ -0,0 +1,109 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/devices/devices.h>
+
+// Two edge sources: 0 is the primary radio, 1 the optional second one
+#define TPMS_EDGE_SOURCE_COUNT 2
+
+typedef struct TPMSEdgeBatcher TPMSEdgeBatcher;
+
+/** Tee callback invoked from the worker thread for every edge of a
+ *  source, before the edge enters the ring. Must be wait-free */
+typedef void (*TPMSEdgeBatcherTeeCallback)(void* context, bool level, uint32_t duration);
+
+/** Allocate TPMSEdgeBatcher with source 0 attached and start its decode
+ *  thread
+ *
+ * @param receiver - SubGhzReceiver the source 0 batches are decoded into
+ * @return TPMSEdgeBatcher*
+ */
+TPMSEdgeBatcher* tpms_edge_batcher_alloc(SubGhzReceiver* receiver);
+
+/** Stop the decode thread and free TPMSEdgeBatcher
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ */
+void tpms_edge_batcher_free(TPMSEdgeBatcher* instance);
+
+/** Attach a receiver to an edge source, allocating its ring on first use.
+ *  Each source keeps its own ring and receiver so the two radios' edge
+ *  streams never interleave inside one decoder state machine
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ * @param source - source slot, < TPMS_EDGE_SOURCE_COUNT
+ * @param receiver - SubGhzReceiver this source decodes into
+ */
+void tpms_edge_batcher_set_source_receiver(
+    TPMSEdgeBatcher* instance,
+    uint8_t source,
+    SubGhzReceiver* receiver);
+
+/** Get the per-source context to hand to SubGhzWorker callbacks
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ * @param source - source slot, < TPMS_EDGE_SOURCE_COUNT
+ * @return opaque context for the pair/overrun callbacks
+ */
+void* tpms_edge_batcher_get_source(TPMSEdgeBatcher* instance, uint8_t source);
+
+/** SubGhzWorker pair callback: push one level/duration pair into the
+ *  source's ring. Wait-free, called from the worker thread
+ *
+ * @param context - source context from tpms_edge_batcher_get_source()
+ * @param level - signal level
+ * @param duration - duration of this level, us
+ */
+void tpms_edge_batcher_pair_callback(void* context, bool level, uint32_t duration);
+
+/** SubGhzWorker overrun callback: remember that the worker stream
+ *  overflowed so this source's decoders get reset once at the next drain
+ *
+ * @param context - source context from tpms_edge_batcher_get_source()
+ */
+void tpms_edge_batcher_overrun_callback(void* context);
+
+/** Tee a source's raw level/duration stream to a second consumer. The
+ *  callback runs in the worker thread for every edge, whether or not the
+ *  edge fits the ring; NULL detaches
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ * @param source - source slot, < TPMS_EDGE_SOURCE_COUNT
+ * @param callback - TPMSEdgeBatcherTeeCallback or NULL
+ * @param context - callback context
+ */
+void tpms_edge_batcher_set_tee(
+    TPMSEdgeBatcher* instance,
+    uint8_t source,
+    TPMSEdgeBatcherTeeCallback callback,
+    void* context);
+
+/** Set the radio whose RSSI gates a source's drain. NULL leaves the
+ *  source ungated
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ * @param source - source slot, < TPMS_EDGE_SOURCE_COUNT
+ * @param device - radio the source's edges come from
+ */
+void tpms_edge_batcher_set_squelch_device(
+    TPMSEdgeBatcher* instance,
+    uint8_t source,
+    const SubGhzDevice* device);
+
+/** Enable or disable the RSSI squelch and set its floor. While the gate
+ *  is closed buffered edges are discarded wholesale before classification
+ *  and decode, and the decoders are resynced once when it reopens
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ * @param enabled - gate edges on RSSI when true
+ * @param floor - RSSI floor, dBm; edges are dropped below it
+ */
+void tpms_edge_batcher_set_squelch(TPMSEdgeBatcher* instance, bool enabled, float floor);
+
+/** Get count of edges lost to ring or worker overruns since alloc
+ *
+ * @param instance - TPMSEdgeBatcher instance
+ * @return lost edge count
+ */
+uint32_t tpms_edge_batcher_get_lost(TPMSEdgeBatcher* instance);
@@ -4,11 +4,23 @@ typedef enum {
     //TPMSCustomEvent
     TPMSCustomEventStartId = 100,
 
+    TPMSCustomEventRadioReady,
+
     TPMSCustomEventSceneSettingLock,
 
+    TPMSCustomEventSceneSensorName,
+    TPMSCustomEventSceneRelearnCapture,
+
     TPMSCustomEventViewReceiverOK,
+    TPMSCustomEventViewReceiverOKLong,
     TPMSCustomEventViewReceiverConfig,
     TPMSCustomEventViewReceiverBack,
     TPMSCustomEventViewReceiverOffDisplay,
     TPMSCustomEventViewReceiverUnlock,
+    TPMSCustomEventViewReceiverSave,
+    TPMSCustomEventViewReceiverRelearn,
+    TPMSCustomEventViewReceiverRelearnRapid,
+
+    TPMSCustomEventViewSweepBack,
+    TPMSCustomEventViewSweepResetPeaks,
 } TPMSCustomEvent;
@@ -0,0 +1,235 @@
+#include "tpms_export.h"
+#include "tpms_types.h"
+#include "../protocols/tpms_generic.h"
+
+#include <storage/storage.h>
+
+#define TAG "TPMSExport"
+
+#define TPMS_EXPORT_DIR EXT_PATH("apps_data/tpms")
+
+// Records are batched into 1KB blocks before hitting the card: aligned
+// writes that spread the cost of a slow SD over whole blocks instead of
+// a storage call per line
+#define TPMS_EXPORT_BUFFER_SIZE 1024
+
+struct TPMSExport {
+    TPMSHistory* history;
+    FuriThread* thread;
+    volatile TPMSExportState state;
+    volatile bool abort;
+    volatile uint16_t done;
+    uint16_t total;
+
+    Storage* storage;
+    File* file;
+    char buffer[TPMS_EXPORT_BUFFER_SIZE];
+    size_t fill;
+    bool write_failed;
+};
+
+static void tpms_export_flush(TPMSExport* instance) {
+    if(!instance->fill) return;
+    size_t written = storage_file_write(instance->file, instance->buffer, instance->fill);
+    if(written != instance->fill) instance->write_failed = true;
+    instance->fill = 0;
+}
+
+static void tpms_export_append(TPMSExport* instance, const char* text) {
+    size_t len = strlen(text);
+    while(len) {
+        size_t space = TPMS_EXPORT_BUFFER_SIZE - instance->fill;
+        size_t chunk = (len < space) ? len : space;
+        memcpy(&instance->buffer[instance->fill], text, chunk);
+        instance->fill += chunk;
+        text += chunk;
+        len -= chunk;
+        if(instance->fill == TPMS_EXPORT_BUFFER_SIZE) tpms_export_flush(instance);
+    }
+}
+
+static void tpms_export_append_record(TPMSExport* instance, uint16_t idx, FuriString* scratch) {
+    // RX keeps running while the worker walks the history: the decode
+    // thread updates records in place and in ring mode rewrites whole
+    // slots (including a preset-name realloc). Snapshot the slot under
+    // the history lock instead of formatting from live storage
+    TPMSHistoryRecord record;
+    SubGhzRadioPreset preset = {.name = furi_string_alloc()};
+    tpms_history_get_record_snapshot(instance->history, idx, &record, &preset);
+
+    FuriString* preset_name = furi_string_alloc();
+    tpms_block_generic_get_preset_name(furi_string_get_cstr(preset.name), preset_name);
+
+    furi_string_printf(
+        scratch,
+        "Frequency: %lu\n"
+        "Preset: %s\n",
+        preset.frequency,
+        furi_string_get_cstr(preset_name));
+    if(!strcmp(furi_string_get_cstr(preset_name), "FuriHalSubGhzPresetCustom")) {
+        furi_string_cat_printf(scratch, "Custom_preset_module: CC1101\nCustom_preset_data:");
+        for(size_t i = 0; i < preset.data_size; i++) {
+            furi_string_cat_printf(scratch, " %02X", preset.data[i]);
+        }
+        furi_string_cat_printf(scratch, "\n");
+    }
+
+    furi_string_cat_printf(
+        scratch,
+        "Protocol: %s\n"
+        "Id: %lu\n"
+        "Bit: %lu\n"
+        "Data:",
+        record.protocol_name,
+        record.id,
+        (uint32_t)record.data_count_bit);
+    for(size_t i = 0; i < sizeof(uint64_t); i++) {
+        furi_string_cat_printf(
+            scratch, " %02X", (uint8_t)(record.data >> ((sizeof(uint64_t) - i - 1) * 8)));
+    }
+    furi_string_cat_printf(
+        scratch,
+        "\n"
+        "Batt: %lu\n"
+        "Pressure: %f\n"
+        "Ts: %lu\n"
+        "Temp: %f\n",
+        (uint32_t)record.battery_low,
+        (double)record.pressure_mb / 1000.0,
+        record.timestamp,
+        (double)record.temperature_dc / 10.0);
+
+    furi_string_free(preset_name);
+    furi_string_free(preset.name);
+    tpms_export_append(instance, furi_string_get_cstr(scratch));
+}
+
+static int32_t tpms_export_worker(void* context) {
+    TPMSExport* instance = context;
+    bool ok = false;
+
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->file = storage_file_alloc(instance->storage);
+    storage_common_mkdir(instance->storage, TPMS_EXPORT_DIR);
+
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+    FuriString* path = furi_string_alloc_printf(
+        "%s/session_%04u%02u%02u_%02u%02u%02u.sub",
+        TPMS_EXPORT_DIR,
+        curr_dt.year,
+        curr_dt.month,
+        curr_dt.day,
+        curr_dt.hour,
+        curr_dt.minute,
+        curr_dt.second);
+
+    if(storage_file_open(
+           instance->file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        FuriString* scratch = furi_string_alloc();
+
+        furi_string_printf(
+            scratch, "Filetype: %s\nVersion: %d\n", TPMS_KEY_FILE_TYPE, TPMS_KEY_FILE_VERSION);
+        tpms_export_append(instance, furi_string_get_cstr(scratch));
+
+        for(uint16_t i = 0; i < instance->total && !instance->abort; i++) {
+            tpms_export_append_record(instance, i, scratch);
+            if(instance->write_failed) break;
+            instance->done = i + 1;
+        }
+        tpms_export_flush(instance);
+        ok = !instance->write_failed && !instance->abort;
+        if(ok) {
+            FURI_LOG_I(TAG, "Saved %u records to %s", instance->done, furi_string_get_cstr(path));
+        }
+
+        furi_string_free(scratch);
+        storage_file_close(instance->file);
+        if(!ok) {
+            // A truncated key file would half-load later, drop it
+            storage_common_remove(instance->storage, furi_string_get_cstr(path));
+        }
+    } else {
+        FURI_LOG_E(TAG, "Failed to open %s", furi_string_get_cstr(path));
+    }
+
+    furi_string_free(path);
+    storage_file_free(instance->file);
+    instance->file = NULL;
+    furi_record_close(RECORD_STORAGE);
+    instance->storage = NULL;
+
+    instance->state = ok ? TPMSExportStateDone : TPMSExportStateError;
+    return 0;
+}
+
+bool tpms_export_start(TPMSExport* instance, TPMSHistory* history) {
+    furi_assert(instance);
+    furi_assert(history);
+    if(instance->state == TPMSExportStateRunning) return false;
+    if(instance->thread) tpms_export_finish(instance);
+
+    uint16_t total = tpms_history_get_item(history);
+    if(!total) return false;
+
+    instance->history = history;
+    instance->total = total;
+    instance->done = 0;
+    instance->abort = false;
+    instance->fill = 0;
+    instance->write_failed = false;
+    instance->state = TPMSExportStateRunning;
+
+    instance->thread = furi_thread_alloc_ex("TPMSExport", 2048, tpms_export_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+    return true;
+}
+
+TPMSExportState tpms_export_get_state(TPMSExport* instance) {
+    furi_assert(instance);
+    return instance->state;
+}
+
+void tpms_export_get_progress(TPMSExport* instance, uint16_t* done, uint16_t* total) {
+    furi_assert(instance);
+    if(done) *done = instance->done;
+    if(total) *total = instance->total;
+}
+
+void tpms_export_cancel(TPMSExport* instance) {
+    furi_assert(instance);
+    instance->abort = true;
+}
+
+void tpms_export_finish(TPMSExport* instance) {
+    furi_assert(instance);
+    if(instance->thread) {
+        furi_thread_join(instance->thread);
+        furi_thread_free(instance->thread);
+        instance->thread = NULL;
+    }
+    instance->state = TPMSExportStateIdle;
+}
+
+TPMSExport* tpms_export_alloc(void) {
+    TPMSExport* instance = malloc(sizeof(TPMSExport));
+    instance->thread = NULL;
+    instance->state = TPMSExportStateIdle;
+    instance->history = NULL;
+    instance->file = NULL;
+    instance->storage = NULL;
+    instance->done = 0;
+    instance->total = 0;
+    instance->abort = false;
+    instance->fill = 0;
+    instance->write_failed = false;
+    return instance;
+}
+
+void tpms_export_free(TPMSExport* instance) {
+    furi_assert(instance);
+    if(instance->state == TPMSExportStateRunning) tpms_export_cancel(instance);
+    tpms_export_finish(instance);
+    free(instance);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <furi.h>
+#include "../tpms_history.h"
+
+typedef struct TPMSExport TPMSExport;
+
+typedef enum {
+    TPMSExportStateIdle,
+    TPMSExportStateRunning,
+    TPMSExportStateDone,
+    TPMSExportStateError,
+} TPMSExportState;
+
+/** Allocate TPMSExport. No thread is started until tpms_export_start()
+ *
+ * @return TPMSExport*
+ */
+TPMSExport* tpms_export_alloc(void);
+
+/** Free TPMSExport, joining the worker first if an export is running
+ *
+ * @param instance - TPMSExport instance
+ */
+void tpms_export_free(TPMSExport* instance);
+
+/** Start exporting every history record to a timestamped key file under
+ *  apps_data/tpms. Serialization and SD writes happen on a worker
+ *  thread; poll tpms_export_get_state() and pick the result up with
+ *  tpms_export_finish()
+ *
+ * @param instance - TPMSExport instance
+ * @param history - history to walk, record count is snapshotted now
+ * @return bool - false when already running or the history is empty
+ */
+bool tpms_export_start(TPMSExport* instance, TPMSHistory* history);
+
+/** Get the current export state
+ *
+ * @param instance - TPMSExport instance
+ * @return TPMSExportState
+ */
+TPMSExportState tpms_export_get_state(TPMSExport* instance);
+
+/** Get export progress in records
+ *
+ * @param instance - TPMSExport instance
+ * @param done - records written so far, may be NULL
+ * @param total - records in this export, may be NULL
+ */
+void tpms_export_get_progress(TPMSExport* instance, uint16_t* done, uint16_t* total);
+
+/** Ask a running export to stop after the record in flight */
+void tpms_export_cancel(TPMSExport* instance);
+
+/** Join the worker and return to Idle. Call after Done/Error, or after
+ *  tpms_export_cancel(); blocks until the worker has released the file
+ *
+ * @param instance - TPMSExport instance
+ */
+void tpms_export_finish(TPMSExport* instance);
@@ -0,0 +1,231 @@
+#include "tpms_raw_capture.h"
+
+#include <storage/storage.h>
+
+#define TAG "TPMSRawCapture"
+
+#define TPMS_RAW_CAPTURE_DIR EXT_PATH("apps_data/tpms")
+
+// Pre-trigger ring, power of two. 2048 packed words (8KB) hold well over
+// a full TPMS burst plus pre-roll at dense edge rates
+#define TPMS_RAW_CAPTURE_RING_SIZE 2048
+#define TPMS_RAW_CAPTURE_RING_MASK (TPMS_RAW_CAPTURE_RING_SIZE - 1)
+
+// Same packing as the edge batcher: level:1 | duration:31
+#define TPMS_RAW_CAPTURE_LEVEL_BIT 0x80000000UL
+
+// Edges kept from before the RSSI gate opened, so the burst dump includes
+// the preamble the trigger itself reacted too late for
+#define TPMS_RAW_CAPTURE_PRE_ROLL 256
+
+// RSSI trigger floor and poll period. 10ms polling bounds how much of a
+// burst tail can be missed while staying invisible next to the SD writes
+#define TPMS_RAW_CAPTURE_RSSI_FLOOR (-85.0f)
+#define TPMS_RAW_CAPTURE_POLL_MS 10
+
+// Consecutive below-floor polls before a burst is considered over, rides
+// out the inter-frame gaps inside one transmission
+#define TPMS_RAW_CAPTURE_END_POLLS 3
+
+#define TPMS_RAW_CAPTURE_FLAG_EXIT (1 << 0)
+
+// Burst header written before each packed word block in the dump file
+typedef struct {
+    uint32_t magic;
+    uint32_t timestamp;
+    uint32_t frequency;
+    uint32_t count;
+} TPMSRawCaptureBurstHeader;
+
+#define TPMS_RAW_CAPTURE_MAGIC 0x57525054UL // "TPRW"
+
+struct TPMSRawCapture {
+    uint32_t* ring; // written by the worker thread only
+    volatile uint32_t head; // free-running, masked on access
+    uint32_t* burst; // trigger thread's copy-out buffer
+    volatile bool enabled;
+    volatile bool active;
+    volatile uint32_t frequency;
+    const SubGhzDevice* device;
+    uint32_t bursts;
+    uint32_t truncated;
+    Storage* storage;
+    File* file;
+    FuriThread* thread;
+    bool running;
+};
+
+void tpms_raw_capture_feed(void* context, bool level, uint32_t duration) {
+    TPMSRawCapture* instance = context;
+    if(!instance->enabled || !instance->active) return;
+
+    // Free-running head: the trigger thread derives spans from it, an
+    // overwrite of unread pre-roll only truncates that burst's dump
+    uint32_t head = instance->head;
+    instance->ring[head & TPMS_RAW_CAPTURE_RING_MASK] =
+        (duration & ~TPMS_RAW_CAPTURE_LEVEL_BIT) | (level ? TPMS_RAW_CAPTURE_LEVEL_BIT : 0);
+    instance->head = head + 1;
+}
+
+static bool tpms_raw_capture_open(TPMSRawCapture* instance) {
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+
+    storage_common_mkdir(instance->storage, TPMS_RAW_CAPTURE_DIR);
+
+    FuriString* path = furi_string_alloc_printf(
+        "%s/raw_%04u%02u%02u_%02u%02u%02u.edges",
+        TPMS_RAW_CAPTURE_DIR,
+        curr_dt.year,
+        curr_dt.month,
+        curr_dt.day,
+        curr_dt.hour,
+        curr_dt.minute,
+        curr_dt.second);
+    bool ok = storage_file_open(
+        instance->file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    if(!ok) {
+        FURI_LOG_E(TAG, "Failed to open %s", furi_string_get_cstr(path));
+    } else {
+        FURI_LOG_I(TAG, "Capturing to %s", furi_string_get_cstr(path));
+    }
+    furi_string_free(path);
+    return ok;
+}
+
+static void tpms_raw_capture_dump(TPMSRawCapture* instance, uint32_t start, uint32_t end) {
+    // Clamp the span if the worker lapped our start while the burst ran
+    uint32_t head = instance->head;
+    if(head - start > TPMS_RAW_CAPTURE_RING_SIZE) {
+        start = head - TPMS_RAW_CAPTURE_RING_SIZE + TPMS_RAW_CAPTURE_PRE_ROLL;
+        instance->truncated++;
+    }
+    uint32_t count = end - start;
+    if(count == 0 || count > TPMS_RAW_CAPTURE_RING_SIZE) return;
+
+    // Copy out first: the ring keeps filling under the worker while the
+    // SD write below takes its time on the stale snapshot
+    for(uint32_t i = 0; i < count; i++) {
+        instance->burst[i] = instance->ring[(start + i) & TPMS_RAW_CAPTURE_RING_MASK];
+    }
+
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+    TPMSRawCaptureBurstHeader header = {
+        .magic = TPMS_RAW_CAPTURE_MAGIC,
+        .timestamp = datetime_datetime_to_timestamp(&curr_dt),
+        .frequency = instance->frequency,
+        .count = count,
+    };
+    storage_file_write(instance->file, &header, sizeof(header));
+    storage_file_write(instance->file, instance->burst, count * sizeof(uint32_t));
+    storage_file_sync(instance->file);
+    instance->bursts++;
+}
+
+static int32_t tpms_raw_capture_worker(void* context) {
+    TPMSRawCapture* instance = context;
+    bool file_open = false;
+    bool capturing = false;
+    uint32_t burst_start = 0;
+    uint8_t quiet_polls = 0;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            TPMS_RAW_CAPTURE_FLAG_EXIT, FuriFlagWaitAny, TPMS_RAW_CAPTURE_POLL_MS);
+        bool exit = (flags != (uint32_t)FuriFlagErrorTimeout) &&
+                    (flags & TPMS_RAW_CAPTURE_FLAG_EXIT);
+
+        if(instance->enabled && instance->active && !exit) {
+            float rssi = subghz_devices_get_rssi(instance->device);
+            if(!capturing) {
+                if(rssi >= TPMS_RAW_CAPTURE_RSSI_FLOOR) {
+                    // Gate opened: retain the pre-roll already in the ring
+                    uint32_t head = instance->head;
+                    burst_start =
+                        (head > TPMS_RAW_CAPTURE_PRE_ROLL) ? head - TPMS_RAW_CAPTURE_PRE_ROLL : 0;
+                    quiet_polls = 0;
+                    capturing = true;
+                }
+            } else if(rssi >= TPMS_RAW_CAPTURE_RSSI_FLOOR) {
+                quiet_polls = 0;
+            } else if(++quiet_polls >= TPMS_RAW_CAPTURE_END_POLLS) {
+                capturing = false;
+                if(!file_open) {
+                    file_open = tpms_raw_capture_open(instance);
+                    if(!file_open) instance->enabled = false;
+                }
+                if(file_open) tpms_raw_capture_dump(instance, burst_start, instance->head);
+            }
+        } else {
+            // RX stopped mid-burst: whatever is buffered stays a partial
+            // burst, dump it rather than lose it
+            if(capturing && file_open) {
+                tpms_raw_capture_dump(instance, burst_start, instance->head);
+            }
+            capturing = false;
+            if(file_open && (!instance->enabled || exit)) {
+                storage_file_close(instance->file);
+                file_open = false;
+            }
+        }
+
+        if(exit) break;
+    }
+    return 0;
+}
+
+void tpms_raw_capture_set_enabled(TPMSRawCapture* instance, bool enabled) {
+    furi_assert(instance);
+    instance->enabled = enabled;
+}
+
+bool tpms_raw_capture_get_enabled(TPMSRawCapture* instance) {
+    furi_assert(instance);
+    return instance->enabled;
+}
+
+void tpms_raw_capture_set_active(TPMSRawCapture* instance, bool active, uint32_t frequency) {
+    furi_assert(instance);
+    if(active) furi_assert(instance->device);
+    instance->frequency = frequency;
+    instance->active = active;
+}
+
+void tpms_raw_capture_set_device(TPMSRawCapture* instance, const SubGhzDevice* device) {
+    furi_assert(instance);
+    furi_assert(device);
+    instance->device = device;
+}
+
+TPMSRawCapture* tpms_raw_capture_alloc(const SubGhzDevice* device) {
+    TPMSRawCapture* instance = malloc(sizeof(TPMSRawCapture));
+    memset(instance, 0, sizeof(TPMSRawCapture));
+    instance->ring = malloc(TPMS_RAW_CAPTURE_RING_SIZE * sizeof(uint32_t));
+    instance->burst = malloc(TPMS_RAW_CAPTURE_RING_SIZE * sizeof(uint32_t));
+    instance->device = device;
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->file = storage_file_alloc(instance->storage);
+
+    instance->thread =
+        furi_thread_alloc_ex("TPMSRawCapture", 1024, tpms_raw_capture_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+    instance->running = true;
+    return instance;
+}
+
+void tpms_raw_capture_free(TPMSRawCapture* instance) {
+    furi_assert(instance);
+    if(instance->running) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_RAW_CAPTURE_FLAG_EXIT);
+        furi_thread_join(instance->thread);
+        instance->running = false;
+    }
+    furi_thread_free(instance->thread);
+    storage_file_free(instance->file);
+    furi_record_close(RECORD_STORAGE);
+    free(instance->burst);
+    free(instance->ring);
+    free(instance);
+}
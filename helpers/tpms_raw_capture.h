@@ -0,0 +1,63 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/devices/devices.h>
+
+typedef struct TPMSRawCapture TPMSRawCapture;
+
+/** Allocate TPMSRawCapture with its pre-allocated rings and start the
+ *  trigger thread. Capture is disabled until tpms_raw_capture_set_enabled()
+ *
+ * @param device - radio whose RSSI triggers burst retention, may be NULL
+ *                 until tpms_raw_capture_set_device()
+ * @return TPMSRawCapture*
+ */
+TPMSRawCapture* tpms_raw_capture_alloc(const SubGhzDevice* device);
+
+/** Attach the trigger radio, used when the radio is probed asynchronously
+ *  after alloc. Must be set before the first tpms_raw_capture_set_active()
+ *
+ * @param instance - TPMSRawCapture instance
+ * @param device - radio whose RSSI triggers burst retention
+ */
+void tpms_raw_capture_set_device(TPMSRawCapture* instance, const SubGhzDevice* device);
+
+/** Close the dump file and free TPMSRawCapture
+ *
+ * @param instance - TPMSRawCapture instance
+ */
+void tpms_raw_capture_free(TPMSRawCapture* instance);
+
+/** Enable or disable RAW capture. Enabling opens a fresh timestamped dump
+ *  file under apps_data/tpms on the first retained burst
+ *
+ * @param instance - TPMSRawCapture instance
+ * @param enabled - retain bursts when true
+ */
+void tpms_raw_capture_set_enabled(TPMSRawCapture* instance, bool enabled);
+
+/** Get whether RAW capture is enabled
+ *
+ * @param instance - TPMSRawCapture instance
+ * @return bool - capture enabled
+ */
+bool tpms_raw_capture_get_enabled(TPMSRawCapture* instance);
+
+/** Mark the radio RX session as running or stopped. The tee only records
+ *  and the trigger thread only reads RSSI while a session is active
+ *
+ * @param instance - TPMSRawCapture instance
+ * @param active - RX session running
+ * @param frequency - tuned frequency, Hz, recorded in burst headers
+ */
+void tpms_raw_capture_set_active(TPMSRawCapture* instance, bool active, uint32_t frequency);
+
+/** Tee callback for the edge batcher: store one packed
+ *  (level:1 | duration:31) word into the free-running pre-trigger ring.
+ *  Wait-free, called from the worker thread on every edge
+ *
+ * @param context - TPMSRawCapture instance
+ * @param level - signal level
+ * @param duration - duration of this level, us
+ */
+void tpms_raw_capture_feed(void* context, bool level, uint32_t duration);
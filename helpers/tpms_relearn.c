@@ -0,0 +1,194 @@
+#include "tpms_relearn.h"
+
+#include <furi_hal.h>
+
+#define TAG "TPMSRelearn"
+
+#define TPMS_RELEARN_FLAG_STOP (1 << 0)
+
+/** One carrier chirp: coil keyed on for on_us, then off for off_us */
+typedef struct {
+    uint16_t on_us;
+    uint16_t off_us;
+} TPMSRelearnChirp;
+
+/** Wake pattern of one OEM family: the chirp sequence is one LF
+ *  telegram, repeated with gap_ms between telegrams to make a burst.
+ *  Rapid mode replays the burst after burst_gap_ms until stopped */
+typedef struct {
+    const TPMSRelearnChirp* chirps;
+    size_t chirp_count;
+    uint16_t repeats; // telegrams per burst
+    uint16_t gap_ms; // between telegrams
+    uint16_t burst_gap_ms; // between bursts in rapid mode
+} TPMSRelearnPattern;
+
+// Plain carrier, the old behaviour: sensors that wake on field presence
+// alone need nothing more. 50 ms chirps x 60 telegrams = 3 s
+static const TPMSRelearnChirp tpms_relearn_chirps_common[] = {
+    {50000, 0},
+};
+
+// Schrader-style: square 125 kHz gating, 5 ms on / 5 ms off
+static const TPMSRelearnChirp tpms_relearn_chirps_schrader[] = {
+    {5000, 5000},
+    {5000, 5000},
+    {5000, 5000},
+    {5000, 5000},
+    {5000, 5000},
+};
+
+// GM/Ford-style: long preamble settles the sensor's LF detector, then a
+// 2 ms OOK pattern
+static const TPMSRelearnChirp tpms_relearn_chirps_gm_ford[] = {
+    {20000, 2000},
+    {2000, 2000},
+    {2000, 4000},
+    {4000, 2000},
+    {2000, 2000},
+    {4000, 4000},
+    {2000, 2000},
+};
+
+// Toyota/Nissan/Hyundai-style: fast 1 ms chirp train with a closing
+// 5 ms marker
+static const TPMSRelearnChirp tpms_relearn_chirps_asian[] = {
+    {1000, 1000},
+    {1000, 1000},
+    {1000, 1000},
+    {1000, 1000},
+    {1000, 1000},
+    {1000, 1000},
+    {1000, 1000},
+    {1000, 1000},
+    {5000, 1000},
+};
+
+static const TPMSRelearnPattern tpms_relearn_patterns[] = {
+    [TPMSRelearnTypeCommon] =
+        {
+            .chirps = tpms_relearn_chirps_common,
+            .chirp_count = COUNT_OF(tpms_relearn_chirps_common),
+            .repeats = 60,
+            .gap_ms = 1,
+            .burst_gap_ms = 500,
+        },
+    [TPMSRelearnTypeSchrader] =
+        {
+            .chirps = tpms_relearn_chirps_schrader,
+            .chirp_count = COUNT_OF(tpms_relearn_chirps_schrader),
+            .repeats = 40,
+            .gap_ms = 20,
+            .burst_gap_ms = 250,
+        },
+    [TPMSRelearnTypeGmFord] =
+        {
+            .chirps = tpms_relearn_chirps_gm_ford,
+            .chirp_count = COUNT_OF(tpms_relearn_chirps_gm_ford),
+            .repeats = 8,
+            .gap_ms = 100,
+            .burst_gap_ms = 250,
+        },
+    [TPMSRelearnTypeAsian] =
+        {
+            .chirps = tpms_relearn_chirps_asian,
+            .chirp_count = COUNT_OF(tpms_relearn_chirps_asian),
+            .repeats = 10,
+            .gap_ms = 50,
+            .burst_gap_ms = 250,
+        },
+};
+
+struct TPMSRelearnWorker {
+    FuriThread* thread;
+    volatile bool running;
+    bool started; // thread needs a join before reuse
+    TPMSRelearnType type;
+    bool rapid;
+};
+
+static int32_t tpms_relearn_worker_thread(void* context) {
+    furi_assert(context);
+    TPMSRelearnWorker* instance = context;
+    const TPMSRelearnPattern* pattern = &tpms_relearn_patterns[instance->type];
+
+    // Carrier hardware runs for the whole burst; chirps only gate it.
+    // Edges are timed with the DWT microsecond delay on this
+    // high-priority thread, so telegram timing does not ride on GUI
+    // scheduling
+    furi_hal_rfid_tim_read_start(125000, 0.5);
+    furi_hal_rfid_tim_read_pause();
+
+    bool stop = false;
+    do {
+        for(uint16_t r = 0; r < pattern->repeats && !stop; r++) {
+            for(size_t i = 0; i < pattern->chirp_count; i++) {
+                const TPMSRelearnChirp* chirp = &pattern->chirps[i];
+                furi_hal_rfid_tim_read_continue();
+                furi_delay_us(chirp->on_us);
+                furi_hal_rfid_tim_read_pause();
+                if(chirp->off_us) furi_delay_us(chirp->off_us);
+            }
+            // The inter-telegram gap doubles as the abort point
+            uint32_t flags = furi_thread_flags_wait(
+                TPMS_RELEARN_FLAG_STOP, FuriFlagWaitAny, furi_ms_to_ticks(pattern->gap_ms));
+            stop = !(flags & FuriFlagError);
+        }
+        if(!stop) {
+            if(!instance->rapid) break;
+            uint32_t flags = furi_thread_flags_wait(
+                TPMS_RELEARN_FLAG_STOP, FuriFlagWaitAny, furi_ms_to_ticks(pattern->burst_gap_ms));
+            stop = !(flags & FuriFlagError);
+        }
+    } while(!stop);
+
+    furi_hal_rfid_tim_read_stop();
+    instance->running = false;
+    return 0;
+}
+
+TPMSRelearnWorker* tpms_relearn_worker_alloc(void) {
+    TPMSRelearnWorker* instance = malloc(sizeof(TPMSRelearnWorker));
+    instance->thread =
+        furi_thread_alloc_ex("TPMSRelearnTx", 1024, tpms_relearn_worker_thread, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityHigh);
+    return instance;
+}
+
+void tpms_relearn_worker_free(TPMSRelearnWorker* instance) {
+    furi_assert(instance);
+    tpms_relearn_worker_stop(instance);
+    furi_thread_free(instance->thread);
+    free(instance);
+}
+
+bool tpms_relearn_worker_start(TPMSRelearnWorker* instance, TPMSRelearnType type, bool rapid) {
+    furi_assert(instance);
+    furi_assert(type < COUNT_OF(tpms_relearn_patterns));
+    if(instance->running) return false;
+    // A one-shot burst ends on its own; reap that thread before reuse
+    if(instance->started) {
+        furi_thread_join(instance->thread);
+        instance->started = false;
+    }
+    instance->type = type;
+    instance->rapid = rapid;
+    instance->running = true;
+    instance->started = true;
+    furi_thread_start(instance->thread);
+    FURI_LOG_I(TAG, "Burst started, type %d%s", type, rapid ? " (rapid)" : "");
+    return true;
+}
+
+void tpms_relearn_worker_stop(TPMSRelearnWorker* instance) {
+    furi_assert(instance);
+    if(!instance->started) return;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_RELEARN_FLAG_STOP);
+    furi_thread_join(instance->thread);
+    instance->started = false;
+}
+
+bool tpms_relearn_worker_is_running(TPMSRelearnWorker* instance) {
+    furi_assert(instance);
+    return instance->running;
+}
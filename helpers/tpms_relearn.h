@@ -0,0 +1,43 @@
+#pragma once
+
+#include <furi.h>
+#include "tpms_types.h"
+
+typedef struct TPMSRelearnWorker TPMSRelearnWorker;
+
+/** Allocate TPMSRelearnWorker. The LF coil is untouched until a burst
+ *  is started
+ *
+ * @return TPMSRelearnWorker*
+ */
+TPMSRelearnWorker* tpms_relearn_worker_alloc(void);
+
+/** Stop any running burst and free TPMSRelearnWorker
+ *
+ * @param instance - TPMSRelearnWorker instance
+ */
+void tpms_relearn_worker_free(TPMSRelearnWorker* instance);
+
+/** Play the wake pattern of one OEM on the 125 kHz coil. The telegram is
+ *  keyed on a dedicated high-priority thread, never on the GUI thread.
+ *  In rapid mode bursts repeat until tpms_relearn_worker_stop()
+ *
+ * @param instance - TPMSRelearnWorker instance
+ * @param type - pattern to play, TPMSRelearnType
+ * @param rapid - repeat bursts until stopped
+ * @return bool - false when a burst is already playing
+ */
+bool tpms_relearn_worker_start(TPMSRelearnWorker* instance, TPMSRelearnType type, bool rapid);
+
+/** Stop the running burst, keying off the coil. Safe to call when idle
+ *
+ * @param instance - TPMSRelearnWorker instance
+ */
+void tpms_relearn_worker_stop(TPMSRelearnWorker* instance);
+
+/** Get whether a burst is currently playing
+ *
+ * @param instance - TPMSRelearnWorker instance
+ * @return bool - playing
+ */
+bool tpms_relearn_worker_is_running(TPMSRelearnWorker* instance);
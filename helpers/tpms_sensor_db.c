@@ -0,0 +1,174 @@
+#include "tpms_sensor_db.h"
+
+#include <storage/storage.h>
+
+#define TAG "TPMSSensorDB"
+
+#define TPMS_SENSOR_DB_DIR EXT_PATH("apps_data/tpms")
+#define TPMS_SENSOR_DB_PATH TPMS_SENSOR_DB_DIR "/sensors.db"
+
+#define TPMS_SENSOR_DB_MAX 1024
+// Open-addressing id hash, power of two, at most half full at capacity
+#define TPMS_SENSOR_DB_INDEX_SIZE 2048
+#define TPMS_SENSOR_DB_INDEX_MASK (TPMS_SENSOR_DB_INDEX_SIZE - 1)
+#define TPMS_SENSOR_DB_INDEX_FREE 0xFFFF
+
+// Records grow in chunks so a shop with ten cars does not pay for a
+// thousand-slot array
+#define TPMS_SENSOR_DB_GROW 64
+
+struct TPMSSensorDB {
+    TPMSSensorDBRecord* records;
+    uint16_t count;
+    uint16_t capacity;
+    bool dirty;
+    Storage* storage;
+    uint16_t index[TPMS_SENSOR_DB_INDEX_SIZE];
+};
+
+static uint32_t tpms_sensor_db_hash(uint32_t id) {
+    // Same avalanche as the history id index
+    id ^= id >> 16;
+    id *= 0x85EBCA6B;
+    id ^= id >> 13;
+    return id;
+}
+
+static void tpms_sensor_db_index_insert(TPMSSensorDB* instance, uint32_t id, uint16_t idx) {
+    uint32_t slot = tpms_sensor_db_hash(id) & TPMS_SENSOR_DB_INDEX_MASK;
+    while(instance->index[slot] != TPMS_SENSOR_DB_INDEX_FREE) {
+        slot = (slot + 1) & TPMS_SENSOR_DB_INDEX_MASK;
+    }
+    instance->index[slot] = idx;
+}
+
+static TPMSSensorDBRecord* tpms_sensor_db_lookup(TPMSSensorDB* instance, uint32_t id) {
+    uint32_t slot = tpms_sensor_db_hash(id) & TPMS_SENSOR_DB_INDEX_MASK;
+    while(instance->index[slot] != TPMS_SENSOR_DB_INDEX_FREE) {
+        TPMSSensorDBRecord* record = &instance->records[instance->index[slot]];
+        if(record->id == id) return record;
+        slot = (slot + 1) & TPMS_SENSOR_DB_INDEX_MASK;
+    }
+    return NULL;
+}
+
+static void tpms_sensor_db_load(TPMSSensorDB* instance) {
+    File* file = storage_file_alloc(instance->storage);
+    if(storage_file_open(file, TPMS_SENSOR_DB_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        uint16_t count = storage_file_size(file) / sizeof(TPMSSensorDBRecord);
+        if(count > TPMS_SENSOR_DB_MAX) count = TPMS_SENSOR_DB_MAX;
+        if(count) {
+            instance->capacity =
+                ((count + TPMS_SENSOR_DB_GROW - 1) / TPMS_SENSOR_DB_GROW) * TPMS_SENSOR_DB_GROW;
+            instance->records =
+                malloc(instance->capacity * sizeof(TPMSSensorDBRecord));
+            instance->count =
+                storage_file_read(
+                    file, instance->records, count * sizeof(TPMSSensorDBRecord)) /
+                sizeof(TPMSSensorDBRecord);
+            for(uint16_t i = 0; i < instance->count; i++) {
+                // Defend against a truncated or hand-edited file
+                instance->records[i].label[TPMS_SENSOR_DB_LABEL_LEN - 1] = '\0';
+                tpms_sensor_db_index_insert(instance, instance->records[i].id, i);
+            }
+        }
+        storage_file_close(file);
+        FURI_LOG_I(TAG, "Loaded %u sensors", instance->count);
+    }
+    storage_file_free(file);
+}
+
+bool tpms_sensor_db_save(TPMSSensorDB* instance) {
+    furi_assert(instance);
+    if(!instance->dirty) return true;
+
+    storage_common_mkdir(instance->storage, TPMS_SENSOR_DB_DIR);
+    File* file = storage_file_alloc(instance->storage);
+    bool ok = storage_file_open(file, TPMS_SENSOR_DB_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    if(ok) {
+        ok = storage_file_write(
+                 file, instance->records, instance->count * sizeof(TPMSSensorDBRecord)) ==
+             instance->count * sizeof(TPMSSensorDBRecord);
+        storage_file_close(file);
+        instance->dirty = !ok;
+    } else {
+        FURI_LOG_E(TAG, "Failed to open %s", TPMS_SENSOR_DB_PATH);
+    }
+    storage_file_free(file);
+    return ok;
+}
+
+const TPMSSensorDBRecord* tpms_sensor_db_find(TPMSSensorDB* instance, uint32_t id) {
+    furi_assert(instance);
+    return tpms_sensor_db_lookup(instance, id);
+}
+
+const char* tpms_sensor_db_get_label(TPMSSensorDB* instance, uint32_t id) {
+    furi_assert(instance);
+    TPMSSensorDBRecord* record = tpms_sensor_db_lookup(instance, id);
+    if(!record || !record->label[0]) return NULL;
+    return record->label;
+}
+
+bool tpms_sensor_db_set_label(TPMSSensorDB* instance, uint32_t id, const char* label) {
+    furi_assert(instance);
+    furi_assert(label);
+
+    TPMSSensorDBRecord* record = tpms_sensor_db_lookup(instance, id);
+    if(!record) {
+        if(instance->count >= TPMS_SENSOR_DB_MAX) return false;
+        if(instance->count == instance->capacity) {
+            instance->capacity += TPMS_SENSOR_DB_GROW;
+            instance->records = realloc(
+                instance->records, instance->capacity * sizeof(TPMSSensorDBRecord));
+        }
+        record = &instance->records[instance->count];
+        memset(record, 0, sizeof(TPMSSensorDBRecord));
+        record->id = id;
+        tpms_sensor_db_index_insert(instance, id, instance->count);
+        instance->count++;
+    }
+
+    strlcpy(record->label, label, TPMS_SENSOR_DB_LABEL_LEN);
+    instance->dirty = true;
+    return true;
+}
+
+void tpms_sensor_db_touch(
+    TPMSSensorDB* instance,
+    uint32_t id,
+    int16_t pressure_cb,
+    int16_t temperature_dc,
+    uint32_t timestamp,
+    uint8_t protocol_index) {
+    furi_assert(instance);
+    TPMSSensorDBRecord* record = tpms_sensor_db_lookup(instance, id);
+    if(!record) return;
+    record->pressure_cb = pressure_cb;
+    record->temperature_dc = temperature_dc;
+    record->last_seen = timestamp;
+    record->protocol_index = protocol_index;
+    instance->dirty = true;
+}
+
+TPMSSensorDB* tpms_sensor_db_alloc(void) {
+    TPMSSensorDB* instance = malloc(sizeof(TPMSSensorDB));
+    instance->records = NULL;
+    instance->count = 0;
+    instance->capacity = 0;
+    instance->dirty = false;
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    for(size_t i = 0; i < TPMS_SENSOR_DB_INDEX_SIZE; i++) {
+        instance->index[i] = TPMS_SENSOR_DB_INDEX_FREE;
+    }
+    tpms_sensor_db_load(instance);
+    return instance;
+}
+
+void tpms_sensor_db_free(TPMSSensorDB* instance) {
+    furi_assert(instance);
+    tpms_sensor_db_save(instance);
+    furi_record_close(RECORD_STORAGE);
+    free(instance->records);
+    free(instance);
+}
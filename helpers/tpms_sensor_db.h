@@ -0,0 +1,82 @@
+#pragma once
+
+#include <furi.h>
+
+#define TPMS_SENSOR_DB_LABEL_LEN 16
+
+/** Fixed 32-byte record, same layout on SD and in RAM so loading is one
+ *  bulk read plus hash inserts */
+typedef struct {
+    uint32_t id;
+    char label[TPMS_SENSOR_DB_LABEL_LEN]; // NUL-terminated
+    int16_t pressure_cb; // last known, bar * 100
+    int16_t temperature_dc; // last known, celsius * 10
+    uint32_t last_seen; // unix timestamp
+    uint8_t protocol_index; // registry order
+    uint8_t reserved[3];
+} TPMSSensorDBRecord;
+
+typedef struct TPMSSensorDB TPMSSensorDB;
+
+/** Allocate TPMSSensorDB and load the database from SD. A thousand
+ *  records is one 32KB read and the hash inserts, a few milliseconds
+ *
+ * @return TPMSSensorDB*
+ */
+TPMSSensorDB* tpms_sensor_db_alloc(void);
+
+/** Save pending changes and free TPMSSensorDB
+ *
+ * @param instance - TPMSSensorDB instance
+ */
+void tpms_sensor_db_free(TPMSSensorDB* instance);
+
+/** Look up a sensor, O(1) via the RAM hash
+ *
+ * @param instance - TPMSSensorDB instance
+ * @param id - sensor id
+ * @return record or NULL when unknown
+ */
+const TPMSSensorDBRecord* tpms_sensor_db_find(TPMSSensorDB* instance, uint32_t id);
+
+/** Get a sensor's label
+ *
+ * @param instance - TPMSSensorDB instance
+ * @param id - sensor id
+ * @return label or NULL when the sensor is unknown or unlabeled
+ */
+const char* tpms_sensor_db_get_label(TPMSSensorDB* instance, uint32_t id);
+
+/** Set a sensor's label, creating its record when unknown. Marks the
+ *  database dirty; call tpms_sensor_db_save() to persist
+ *
+ * @param instance - TPMSSensorDB instance
+ * @param id - sensor id
+ * @param label - label text, truncated to TPMS_SENSOR_DB_LABEL_LEN - 1
+ * @return true on success, false when the database is full
+ */
+bool tpms_sensor_db_set_label(TPMSSensorDB* instance, uint32_t id, const char* label);
+
+/** Refresh a known sensor's last-seen values, no record is created
+ *
+ * @param instance - TPMSSensorDB instance
+ * @param id - sensor id
+ * @param pressure_cb - pressure, bar * 100
+ * @param temperature_dc - temperature, celsius * 10
+ * @param timestamp - unix timestamp of the frame
+ * @param protocol_index - protocol registry index
+ */
+void tpms_sensor_db_touch(
+    TPMSSensorDB* instance,
+    uint32_t id,
+    int16_t pressure_cb,
+    int16_t temperature_dc,
+    uint32_t timestamp,
+    uint8_t protocol_index);
+
+/** Write the database back to SD if it changed
+ *
+ * @param instance - TPMSSensorDB instance
+ * @return true on success or nothing to do
+ */
+bool tpms_sensor_db_save(TPMSSensorDB* instance);
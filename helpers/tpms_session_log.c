@@ -0,0 +1,194 @@
+#include "tpms_session_log.h"
+#include "../protocols/tpms_generic.h"
+#include "../protocols/protocol_items.h"
+
+#include <storage/storage.h>
+
+#define TAG "TPMSSessionLog"
+
+#define TPMS_SESSION_LOG_DIR EXT_PATH("apps_data/tpms")
+
+// Ring capacity in records and the batch size that triggers a flush;
+// 64 records is ~1.5KB, a comfortable append-only SD write
+#define TPMS_SESSION_LOG_RING_SIZE 256
+#define TPMS_SESSION_LOG_RING_MASK (TPMS_SESSION_LOG_RING_SIZE - 1)
+#define TPMS_SESSION_LOG_FLUSH_COUNT 64
+
+#define TPMS_SESSION_LOG_FLAG_DATA (1 << 0)
+#define TPMS_SESSION_LOG_FLAG_EXIT (1 << 1)
+
+struct TPMSSessionLog {
+    TPMSSessionLogRecord* ring;
+    volatile uint32_t head; // written by the decode thread only
+    volatile uint32_t tail; // written by the writer thread only
+    volatile bool enabled;
+    uint32_t dropped;
+    Storage* storage;
+    File* file;
+    FuriThread* thread;
+    bool running;
+};
+
+static uint8_t tpms_session_log_protocol_index(const SubGhzProtocol* protocol) {
+    for(size_t i = 0; i < subghz_protocol_registry_count(&tpms_protocol_registry); i++) {
+        if(subghz_protocol_registry_get_by_index(&tpms_protocol_registry, i) == protocol) {
+            return i;
+        }
+    }
+    return 0xFF;
+}
+
+void tpms_session_log_append(
+    TPMSSessionLog* instance,
+    SubGhzProtocolDecoderBase* decoder_base,
+    SubGhzRadioPreset* preset) {
+    furi_assert(instance);
+    furi_assert(decoder_base);
+    if(!instance->enabled) return;
+
+    const TPMSBlockGeneric* generic = tpms_protocol_get_generic(decoder_base);
+    if(!generic) return;
+
+    uint32_t head = instance->head;
+    uint32_t next = (head + 1) & TPMS_SESSION_LOG_RING_MASK;
+    if(next == instance->tail) {
+        // Ring full: the SD card is not keeping up, drop this record
+        instance->dropped++;
+        return;
+    }
+
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+
+    TPMSSessionLogRecord* record = &instance->ring[head];
+    record->timestamp = datetime_datetime_to_timestamp(&curr_dt);
+    record->id = generic->id;
+    record->pressure_mb = generic->pressure_mb;
+    record->temperature_dc = generic->temperature_dc;
+    record->frequency = preset ? preset->frequency : 0;
+    record->battery_low = generic->battery_low;
+    record->protocol_index = tpms_session_log_protocol_index(decoder_base->protocol);
+    record->reserved = 0;
+    record->reserved2 = 0;
+    instance->head = next;
+
+    // Wake the writer only when a whole batch is pending
+    uint32_t pending = (next - instance->tail) & TPMS_SESSION_LOG_RING_MASK;
+    if(pending >= TPMS_SESSION_LOG_FLUSH_COUNT) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_SESSION_LOG_FLAG_DATA);
+    }
+}
+
+static bool tpms_session_log_open(TPMSSessionLog* instance) {
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+
+    storage_common_mkdir(instance->storage, TPMS_SESSION_LOG_DIR);
+
+    FuriString* path = furi_string_alloc_printf(
+        "%s/session_%04u%02u%02u_%02u%02u%02u.tpms",
+        TPMS_SESSION_LOG_DIR,
+        curr_dt.year,
+        curr_dt.month,
+        curr_dt.day,
+        curr_dt.hour,
+        curr_dt.minute,
+        curr_dt.second);
+    bool ok = storage_file_open(
+        instance->file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    if(!ok) {
+        FURI_LOG_E(TAG, "Failed to open %s", furi_string_get_cstr(path));
+    } else {
+        FURI_LOG_I(TAG, "Logging to %s", furi_string_get_cstr(path));
+    }
+    furi_string_free(path);
+    return ok;
+}
+
+static void tpms_session_log_flush(TPMSSessionLog* instance) {
+    // Write contiguous spans of the ring; at most two per flush
+    while(instance->tail != instance->head) {
+        uint32_t tail = instance->tail;
+        uint32_t head = instance->head;
+        uint32_t count = (head > tail) ? (head - tail) : (TPMS_SESSION_LOG_RING_SIZE - tail);
+        storage_file_write(
+            instance->file, &instance->ring[tail], count * sizeof(TPMSSessionLogRecord));
+        instance->tail = (tail + count) & TPMS_SESSION_LOG_RING_MASK;
+    }
+    storage_file_sync(instance->file);
+}
+
+static int32_t tpms_session_log_worker(void* context) {
+    TPMSSessionLog* instance = context;
+    bool file_open = false;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            TPMS_SESSION_LOG_FLAG_DATA | TPMS_SESSION_LOG_FLAG_EXIT, FuriFlagWaitAny, 1000);
+        bool exit = (flags != (uint32_t)FuriFlagErrorTimeout) &&
+                    (flags & TPMS_SESSION_LOG_FLAG_EXIT);
+
+        if(instance->enabled && !file_open) {
+            file_open = tpms_session_log_open(instance);
+            if(!file_open) instance->enabled = false;
+        }
+
+        if(file_open) {
+            tpms_session_log_flush(instance);
+            if(!instance->enabled || exit) {
+                storage_file_close(instance->file);
+                file_open = false;
+            }
+        } else {
+            // Nothing to keep: drain the ring so stale records do not
+            // leak into the next session
+            instance->tail = instance->head;
+        }
+
+        if(exit) break;
+    }
+    return 0;
+}
+
+void tpms_session_log_set_enabled(TPMSSessionLog* instance, bool enabled) {
+    furi_assert(instance);
+    instance->enabled = enabled;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_SESSION_LOG_FLAG_DATA);
+}
+
+bool tpms_session_log_get_enabled(TPMSSessionLog* instance) {
+    furi_assert(instance);
+    return instance->enabled;
+}
+
+TPMSSessionLog* tpms_session_log_alloc(void) {
+    TPMSSessionLog* instance = malloc(sizeof(TPMSSessionLog));
+    instance->ring = malloc(TPMS_SESSION_LOG_RING_SIZE * sizeof(TPMSSessionLogRecord));
+    instance->head = 0;
+    instance->tail = 0;
+    instance->enabled = false;
+    instance->dropped = 0;
+    instance->storage = furi_record_open(RECORD_STORAGE);
+    instance->file = storage_file_alloc(instance->storage);
+
+    instance->thread =
+        furi_thread_alloc_ex("TPMSSessionLog", 1024, tpms_session_log_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+    instance->running = true;
+    return instance;
+}
+
+void tpms_session_log_free(TPMSSessionLog* instance) {
+    furi_assert(instance);
+    if(instance->running) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_SESSION_LOG_FLAG_EXIT);
+        furi_thread_join(instance->thread);
+        instance->running = false;
+    }
+    furi_thread_free(instance->thread);
+    storage_file_free(instance->file);
+    furi_record_close(RECORD_STORAGE);
+    free(instance->ring);
+    free(instance);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/protocols/base.h>
+#include <lib/subghz/types.h>
+
+typedef struct TPMSSessionLog TPMSSessionLog;
+
+/** One fixed-size on-disk record, packed little-endian as stored in RAM.
+ *  Readings are fixed point like the rest of the pipeline; padding keeps
+ *  the record at the 24 bytes older tooling expects */
+typedef struct __attribute__((packed)) {
+    uint32_t timestamp; // RTC seconds
+    uint32_t id;
+    int32_t pressure_mb; // millibar
+    int16_t temperature_dc; // celsius * 10
+    uint16_t reserved;
+    uint32_t frequency; // Hz
+    uint8_t battery_low;
+    uint8_t protocol_index; // registry slot
+    uint16_t reserved2;
+} TPMSSessionLogRecord;
+
+/** Allocate TPMSSessionLog and start its writer thread. Logging is
+ *  disabled until tpms_session_log_set_enabled()
+ *
+ * @return TPMSSessionLog*
+ */
+TPMSSessionLog* tpms_session_log_alloc(void);
+
+/** Flush pending records, close the file and free TPMSSessionLog
+ *
+ * @param instance - TPMSSessionLog instance
+ */
+void tpms_session_log_free(TPMSSessionLog* instance);
+
+/** Enable or disable logging. Enabling opens a fresh timestamped session
+ *  file under apps_data/tpms, disabling flushes and closes it; both
+ *  happen on the writer thread
+ *
+ * @param instance - TPMSSessionLog instance
+ * @param enabled - log decoded frames when true
+ */
+void tpms_session_log_set_enabled(TPMSSessionLog* instance, bool enabled);
+
+/** Get whether logging is enabled
+ *
+ * @param instance - TPMSSessionLog instance
+ * @return bool - logging enabled
+ */
+bool tpms_session_log_get_enabled(TPMSSessionLog* instance);
+
+/** Append one decoded frame. Wait-free: copies the record into the RAM
+ *  ring, the writer thread flushes to SD in batches
+ *
+ * @param instance - TPMSSessionLog instance
+ * @param decoder_base - decoder that produced the frame
+ * @param preset - radio preset the frame was received with
+ */
+void tpms_session_log_append(
+    TPMSSessionLog* instance,
+    SubGhzProtocolDecoderBase* decoder_base,
+    SubGhzRadioPreset* preset);
@@ -0,0 +1,339 @@
+#include "tpms_setting.h"
+
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "TPMSSetting"
+
+#define TPMS_SETTING_CACHE_MAGIC 0x43535054 // "TPSC"
+#define TPMS_SETTING_CACHE_VERSION 1
+
+// Sanity bounds for a cache written by a different build or corrupted on SD
+#define TPMS_SETTING_CACHE_MAX_FREQUENCIES 256
+#define TPMS_SETTING_CACHE_MAX_PRESETS 16
+#define TPMS_SETTING_CACHE_MAX_PRESET_DATA 256
+#define TPMS_SETTING_CACHE_PRESET_NAME_LEN 32
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    // Staleness check: the cache is valid only while the source text file
+    // still has this size and modification time
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t frequency_count;
+    uint32_t frequency_default_index;
+    uint32_t hopper_count;
+    uint32_t custom_preset_count;
+} TPMSSettingCacheHeader;
+
+typedef struct {
+    char name[TPMS_SETTING_CACHE_PRESET_NAME_LEN];
+    uint32_t data_size;
+} TPMSSettingCachePresetHeader;
+
+struct TPMSSetting {
+    SubGhzSetting* subghz_setting;
+    uint32_t* frequencies;
+    uint32_t frequency_count;
+    uint32_t frequency_default_index;
+    uint32_t* hopper_frequencies;
+    uint32_t hopper_count;
+};
+
+static void tpms_setting_source_stat(
+    Storage* storage,
+    const char* file_path,
+    uint32_t* size,
+    uint32_t* timestamp) {
+    FileInfo file_info;
+    *size = 0;
+    *timestamp = 0;
+    if(storage_common_stat(storage, file_path, &file_info) == FSE_OK) {
+        *size = file_info.size;
+    }
+    storage_common_timestamp(storage, file_path, timestamp);
+}
+
+/* Replay a cached custom preset into the SubGhzSetting through an
+ * in-RAM FlipperFormat, no SD round trip */
+static void tpms_setting_cache_restore_preset(
+    TPMSSetting* instance,
+    const char* name,
+    const uint8_t* data,
+    size_t data_size) {
+    FlipperFormat* fff = flipper_format_string_alloc();
+    flipper_format_write_string_cstr(fff, "Custom_preset_module", "CC1101");
+    flipper_format_write_hex(fff, "Custom_preset_data", data, data_size);
+    flipper_format_rewind(fff);
+    subghz_setting_load_custom_preset(instance->subghz_setting, name, fff);
+    flipper_format_free(fff);
+}
+
+static bool tpms_setting_cache_read(
+    TPMSSetting* instance,
+    Storage* storage,
+    const char* cache_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    bool ok = false;
+    File* file = storage_file_alloc(storage);
+    do {
+        if(!storage_file_open(file, cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        TPMSSettingCacheHeader header;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != TPMS_SETTING_CACHE_MAGIC) break;
+        if(header.version != TPMS_SETTING_CACHE_VERSION) break;
+        if(header.source_size != source_size) break;
+        if(header.source_timestamp != source_timestamp) break;
+        if(header.frequency_count == 0) break;
+        if(header.frequency_count > TPMS_SETTING_CACHE_MAX_FREQUENCIES) break;
+        if(header.hopper_count > TPMS_SETTING_CACHE_MAX_FREQUENCIES) break;
+        if(header.frequency_default_index >= header.frequency_count) break;
+        if(header.custom_preset_count > TPMS_SETTING_CACHE_MAX_PRESETS) break;
+
+        size_t frequencies_size = header.frequency_count * sizeof(uint32_t);
+        size_t hopper_size = header.hopper_count * sizeof(uint32_t);
+        instance->frequencies = malloc(frequencies_size);
+        instance->hopper_frequencies = hopper_size ? malloc(hopper_size) : NULL;
+        if(storage_file_read(file, instance->frequencies, frequencies_size) !=
+           frequencies_size)
+            break;
+        if(hopper_size &&
+           storage_file_read(file, instance->hopper_frequencies, hopper_size) != hopper_size)
+            break;
+        instance->frequency_count = header.frequency_count;
+        instance->frequency_default_index = header.frequency_default_index;
+        instance->hopper_count = header.hopper_count;
+
+        // Presets: built-in defaults plus the cached custom blobs
+        subghz_setting_load_default(instance->subghz_setting);
+
+        uint8_t preset_data[TPMS_SETTING_CACHE_MAX_PRESET_DATA];
+        uint32_t preset = 0;
+        for(; preset < header.custom_preset_count; preset++) {
+            TPMSSettingCachePresetHeader preset_header;
+            if(storage_file_read(file, &preset_header, sizeof(preset_header)) !=
+               sizeof(preset_header))
+                break;
+            if(preset_header.data_size > TPMS_SETTING_CACHE_MAX_PRESET_DATA) break;
+            preset_header.name[TPMS_SETTING_CACHE_PRESET_NAME_LEN - 1] = '\0';
+            if(storage_file_read(file, preset_data, preset_header.data_size) !=
+               preset_header.data_size)
+                break;
+            tpms_setting_cache_restore_preset(
+                instance, preset_header.name, preset_data, preset_header.data_size);
+        }
+        if(preset != header.custom_preset_count) break;
+
+        ok = true;
+    } while(false);
+    storage_file_close(file);
+    storage_file_free(file);
+    return ok;
+}
+
+static void tpms_setting_cache_write(
+    TPMSSetting* instance,
+    Storage* storage,
+    const char* cache_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    // Custom presets are the ones the text parse appended after the
+    // built-in defaults; count the defaults with a scratch instance
+    SubGhzSetting* scratch = subghz_setting_alloc();
+    subghz_setting_load_default(scratch);
+    size_t default_preset_count = subghz_setting_get_preset_count(scratch);
+    subghz_setting_free(scratch);
+
+    size_t preset_count = subghz_setting_get_preset_count(instance->subghz_setting);
+    uint32_t custom_preset_count = 0;
+    if(preset_count > default_preset_count) {
+        custom_preset_count =
+            MIN(preset_count - default_preset_count, (size_t)TPMS_SETTING_CACHE_MAX_PRESETS);
+    }
+
+    TPMSSettingCacheHeader header = {
+        .magic = TPMS_SETTING_CACHE_MAGIC,
+        .version = TPMS_SETTING_CACHE_VERSION,
+        .source_size = source_size,
+        .source_timestamp = source_timestamp,
+        .frequency_count = instance->frequency_count,
+        .frequency_default_index = instance->frequency_default_index,
+        .hopper_count = instance->hopper_count,
+        .custom_preset_count = custom_preset_count,
+    };
+
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, cache_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        bool ok = storage_file_write(file, &header, sizeof(header)) == sizeof(header);
+        ok = ok && storage_file_write(
+                       file,
+                       instance->frequencies,
+                       instance->frequency_count * sizeof(uint32_t)) ==
+                       instance->frequency_count * sizeof(uint32_t);
+        if(instance->hopper_count) {
+            ok = ok && storage_file_write(
+                           file,
+                           instance->hopper_frequencies,
+                           instance->hopper_count * sizeof(uint32_t)) ==
+                           instance->hopper_count * sizeof(uint32_t);
+        }
+        for(uint32_t i = 0; ok && i < custom_preset_count; i++) {
+            size_t idx = default_preset_count + i;
+            TPMSSettingCachePresetHeader preset_header = {0};
+            strlcpy(
+                preset_header.name,
+                subghz_setting_get_preset_name(instance->subghz_setting, idx),
+                TPMS_SETTING_CACHE_PRESET_NAME_LEN);
+            preset_header.data_size = MIN(
+                subghz_setting_get_preset_data_size(instance->subghz_setting, idx),
+                (size_t)TPMS_SETTING_CACHE_MAX_PRESET_DATA);
+            ok = storage_file_write(file, &preset_header, sizeof(preset_header)) ==
+                 sizeof(preset_header);
+            ok = ok && storage_file_write(
+                           file,
+                           subghz_setting_get_preset_data(instance->subghz_setting, idx),
+                           preset_header.data_size) == preset_header.data_size;
+        }
+        storage_file_close(file);
+        if(!ok) {
+            FURI_LOG_E(TAG, "Cache write failed");
+            storage_common_remove(storage, cache_path);
+        }
+    }
+    storage_file_free(file);
+}
+
+void tpms_setting_load(TPMSSetting* instance, const char* file_path) {
+    furi_assert(instance);
+    furi_assert(file_path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    tpms_setting_source_stat(storage, file_path, &source_size, &source_timestamp);
+
+    FuriString* cache_path = furi_string_alloc_printf("%s.cache", file_path);
+
+    if(tpms_setting_cache_read(
+           instance,
+           storage,
+           furi_string_get_cstr(cache_path),
+           source_size,
+           source_timestamp)) {
+        FURI_LOG_I(TAG, "Settings from cache, %lu frequencies", instance->frequency_count);
+    } else {
+        // Cold path: text parse, then mirror the tables and refresh the
+        // cache for the next launch
+        free(instance->frequencies);
+        free(instance->hopper_frequencies);
+        subghz_setting_load(instance->subghz_setting, file_path);
+
+        instance->frequency_count =
+            subghz_setting_get_frequency_count(instance->subghz_setting);
+        instance->frequency_default_index =
+            subghz_setting_get_frequency_default_index(instance->subghz_setting);
+        instance->hopper_count =
+            subghz_setting_get_hopper_frequency_count(instance->subghz_setting);
+        instance->frequencies = malloc(instance->frequency_count * sizeof(uint32_t));
+        instance->hopper_frequencies =
+            instance->hopper_count ? malloc(instance->hopper_count * sizeof(uint32_t)) : NULL;
+        for(uint32_t i = 0; i < instance->frequency_count; i++) {
+            instance->frequencies[i] =
+                subghz_setting_get_frequency(instance->subghz_setting, i);
+        }
+        for(uint32_t i = 0; i < instance->hopper_count; i++) {
+            instance->hopper_frequencies[i] =
+                subghz_setting_get_hopper_frequency(instance->subghz_setting, i);
+        }
+
+        tpms_setting_cache_write(
+            instance,
+            storage,
+            furi_string_get_cstr(cache_path),
+            source_size,
+            source_timestamp);
+    }
+
+    furi_string_free(cache_path);
+    furi_record_close(RECORD_STORAGE);
+}
+
+size_t tpms_setting_get_frequency_count(TPMSSetting* instance) {
+    furi_assert(instance);
+    return instance->frequency_count;
+}
+
+uint32_t tpms_setting_get_frequency(TPMSSetting* instance, size_t idx) {
+    furi_assert(instance);
+    furi_assert(idx < instance->frequency_count);
+    return instance->frequencies[idx];
+}
+
+uint32_t tpms_setting_get_frequency_default_index(TPMSSetting* instance) {
+    furi_assert(instance);
+    return instance->frequency_default_index;
+}
+
+uint32_t tpms_setting_get_default_frequency(TPMSSetting* instance) {
+    furi_assert(instance);
+    return instance->frequencies[instance->frequency_default_index];
+}
+
+size_t tpms_setting_get_hopper_frequency_count(TPMSSetting* instance) {
+    furi_assert(instance);
+    return instance->hopper_count;
+}
+
+uint32_t tpms_setting_get_hopper_frequency(TPMSSetting* instance, size_t idx) {
+    furi_assert(instance);
+    furi_assert(idx < instance->hopper_count);
+    return instance->hopper_frequencies[idx];
+}
+
+size_t tpms_setting_get_preset_count(TPMSSetting* instance) {
+    furi_assert(instance);
+    return subghz_setting_get_preset_count(instance->subghz_setting);
+}
+
+const char* tpms_setting_get_preset_name(TPMSSetting* instance, size_t idx) {
+    furi_assert(instance);
+    return subghz_setting_get_preset_name(instance->subghz_setting, idx);
+}
+
+uint8_t* tpms_setting_get_preset_data(TPMSSetting* instance, size_t idx) {
+    furi_assert(instance);
+    return subghz_setting_get_preset_data(instance->subghz_setting, idx);
+}
+
+size_t tpms_setting_get_preset_data_size(TPMSSetting* instance, size_t idx) {
+    furi_assert(instance);
+    return subghz_setting_get_preset_data_size(instance->subghz_setting, idx);
+}
+
+uint8_t* tpms_setting_get_preset_data_by_name(TPMSSetting* instance, const char* preset_name) {
+    furi_assert(instance);
+    return subghz_setting_get_preset_data_by_name(instance->subghz_setting, preset_name);
+}
+
+TPMSSetting* tpms_setting_alloc(void) {
+    TPMSSetting* instance = malloc(sizeof(TPMSSetting));
+    instance->subghz_setting = subghz_setting_alloc();
+    instance->frequencies = NULL;
+    instance->frequency_count = 0;
+    instance->frequency_default_index = 0;
+    instance->hopper_frequencies = NULL;
+    instance->hopper_count = 0;
+    return instance;
+}
+
+void tpms_setting_free(TPMSSetting* instance) {
+    furi_assert(instance);
+    subghz_setting_free(instance->subghz_setting);
+    free(instance->frequencies);
+    free(instance->hopper_frequencies);
+    free(instance);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/subghz_setting.h>
+
+typedef struct TPMSSetting TPMSSetting;
+
+/** Allocate TPMSSetting
+ *
+ * @return TPMSSetting*
+ */
+TPMSSetting* tpms_setting_alloc(void);
+
+/** Free TPMSSetting
+ *
+ * @param instance - TPMSSetting instance
+ */
+void tpms_setting_free(TPMSSetting* instance);
+
+/** Load settings, accelerated by a binary cache kept next to the text
+ *  file. When the cache matches the source file's size and timestamp the
+ *  frequency/hopper tables and custom presets come from one block read;
+ *  otherwise the text file is parsed the slow way and the cache is
+ *  rewritten
+ *
+ * @param instance - TPMSSetting instance
+ * @param file_path - path of the subghz setting text file
+ */
+void tpms_setting_load(TPMSSetting* instance, const char* file_path);
+
+size_t tpms_setting_get_frequency_count(TPMSSetting* instance);
+uint32_t tpms_setting_get_frequency(TPMSSetting* instance, size_t idx);
+uint32_t tpms_setting_get_frequency_default_index(TPMSSetting* instance);
+uint32_t tpms_setting_get_default_frequency(TPMSSetting* instance);
+size_t tpms_setting_get_hopper_frequency_count(TPMSSetting* instance);
+uint32_t tpms_setting_get_hopper_frequency(TPMSSetting* instance, size_t idx);
+
+/* Presets always live in the wrapped SubGhzSetting, straight passthrough */
+size_t tpms_setting_get_preset_count(TPMSSetting* instance);
+const char* tpms_setting_get_preset_name(TPMSSetting* instance, size_t idx);
+uint8_t* tpms_setting_get_preset_data(TPMSSetting* instance, size_t idx);
+size_t tpms_setting_get_preset_data_size(TPMSSetting* instance, size_t idx);
+uint8_t* tpms_setting_get_preset_data_by_name(TPMSSetting* instance, const char* preset_name);
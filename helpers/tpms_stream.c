@@ -0,0 +1,202 @@
+#include "tpms_stream.h"
+#include "../protocols/tpms_generic.h"
+#include "../protocols/tpms_crc.h"
+#include "../protocols/protocol_items.h"
+
+#include <furi_hal.h>
+
+#define TAG "TPMSStream"
+
+// LPUART on pins 15/16; the USB CDC channels belong to the system
+// CLI/RPC, a FAP cannot stream on them without tearing that down
+#define TPMS_STREAM_BAUD 230400
+
+// Ring capacity in events; at this baud the sender drains an event in
+// ~1.5 ms, the ring only fills when nothing is listening
+#define TPMS_STREAM_RING_SIZE 64
+#define TPMS_STREAM_RING_MASK (TPMS_STREAM_RING_SIZE - 1)
+
+#define TPMS_STREAM_FLAG_DATA (1 << 0)
+#define TPMS_STREAM_FLAG_EXIT (1 << 1)
+
+struct TPMSStream {
+    TPMSStreamEvent* ring;
+    uint32_t head;
+    uint32_t tail;
+    // Unlike the session log ring both sides move the tail here
+    // (drop-oldest), so the indexes live under a mutex instead of the
+    // single-producer/single-consumer split
+    FuriMutex* mutex;
+    volatile bool enabled;
+    uint32_t seq;
+    uint32_t device_id;
+    FuriHalSerialHandle* serial;
+    FuriThread* thread;
+    bool running;
+};
+
+static uint8_t tpms_stream_protocol_index(const SubGhzProtocol* protocol) {
+    for(size_t i = 0; i < subghz_protocol_registry_count(&tpms_protocol_registry); i++) {
+        if(subghz_protocol_registry_get_by_index(&tpms_protocol_registry, i) == protocol) {
+            return i;
+        }
+    }
+    return 0xFF;
+}
+
+// Fold the MCU unique id into the 32-bit device field; collisions over a
+// handful of units are not a concern
+static uint32_t tpms_stream_device_id(void) {
+    const uint8_t* uid = furi_hal_version_uid();
+    uint32_t id = 0;
+    for(size_t i = 0; i < furi_hal_version_uid_size(); i++) {
+        id = (id << 8) | (id >> 24);
+        id ^= uid[i];
+    }
+    return id;
+}
+
+void tpms_stream_push(
+    TPMSStream* instance,
+    SubGhzProtocolDecoderBase* decoder_base,
+    SubGhzRadioPreset* preset) {
+    furi_assert(instance);
+    furi_assert(decoder_base);
+    if(!instance->enabled) return;
+
+    const TPMSBlockGeneric* generic = tpms_protocol_get_generic(decoder_base);
+    if(!generic) return;
+
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    uint32_t head = instance->head;
+    uint32_t next = (head + 1) & TPMS_STREAM_RING_MASK;
+    if(next == instance->tail) {
+        // Nothing is draining the wire: the oldest pending event goes,
+        // its sequence number shows up as a gap on the collector
+        instance->tail = (instance->tail + 1) & TPMS_STREAM_RING_MASK;
+    }
+
+    TPMSStreamEvent* event = &instance->ring[head];
+    event->magic[0] = 'T';
+    event->magic[1] = 'S';
+    event->version = TPMS_STREAM_EVENT_VERSION;
+    event->reserved = 0;
+    event->device_id = instance->device_id;
+    event->seq = instance->seq++;
+    event->record.timestamp = datetime_datetime_to_timestamp(&curr_dt);
+    event->record.id = generic->id;
+    event->record.pressure_mb = generic->pressure_mb;
+    event->record.temperature_dc = generic->temperature_dc;
+    event->record.frequency = preset ? preset->frequency : 0;
+    event->record.battery_low = generic->battery_low;
+    event->record.protocol_index = tpms_stream_protocol_index(decoder_base->protocol);
+    event->record.reserved = 0;
+    event->record.reserved2 = 0;
+    event->crc = tpms_crc8_0x07((const uint8_t*)event, sizeof(TPMSStreamEvent) - 1, 0x00);
+    instance->head = next;
+    furi_mutex_release(instance->mutex);
+
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_STREAM_FLAG_DATA);
+}
+
+static int32_t tpms_stream_worker(void* context) {
+    TPMSStream* instance = context;
+    bool port_open = false;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            TPMS_STREAM_FLAG_DATA | TPMS_STREAM_FLAG_EXIT, FuriFlagWaitAny, 1000);
+        bool exit =
+            (flags != (uint32_t)FuriFlagErrorTimeout) && (flags & TPMS_STREAM_FLAG_EXIT);
+
+        if(instance->enabled && !port_open) {
+            instance->serial = furi_hal_serial_control_acquire(FuriHalSerialIdLpuart);
+            if(instance->serial) {
+                furi_hal_serial_init(instance->serial, TPMS_STREAM_BAUD);
+                port_open = true;
+                FURI_LOG_I(TAG, "Streaming on LPUART, device 0x%08lX", instance->device_id);
+            } else {
+                FURI_LOG_E(TAG, "LPUART busy");
+                instance->enabled = false;
+            }
+        }
+
+        if(port_open) {
+            // One event at a time: the copy keeps the mutex hold short
+            // and the wire write happens outside it
+            while(true) {
+                TPMSStreamEvent event;
+                furi_mutex_acquire(instance->mutex, FuriWaitForever);
+                bool pending = (instance->tail != instance->head);
+                if(pending) {
+                    event = instance->ring[instance->tail];
+                    instance->tail = (instance->tail + 1) & TPMS_STREAM_RING_MASK;
+                }
+                furi_mutex_release(instance->mutex);
+                if(!pending) break;
+                furi_hal_serial_tx(instance->serial, (const uint8_t*)&event, sizeof(event));
+            }
+            if(!instance->enabled || exit) {
+                furi_hal_serial_tx_wait_complete(instance->serial);
+                furi_hal_serial_deinit(instance->serial);
+                furi_hal_serial_control_release(instance->serial);
+                instance->serial = NULL;
+                port_open = false;
+            }
+        } else {
+            // Not streaming: drain the ring so stale events do not leak
+            // into the next session
+            furi_mutex_acquire(instance->mutex, FuriWaitForever);
+            instance->tail = instance->head;
+            furi_mutex_release(instance->mutex);
+        }
+
+        if(exit) break;
+    }
+    return 0;
+}
+
+void tpms_stream_set_enabled(TPMSStream* instance, bool enabled) {
+    furi_assert(instance);
+    instance->enabled = enabled;
+    furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_STREAM_FLAG_DATA);
+}
+
+bool tpms_stream_get_enabled(TPMSStream* instance) {
+    furi_assert(instance);
+    return instance->enabled;
+}
+
+TPMSStream* tpms_stream_alloc(void) {
+    TPMSStream* instance = malloc(sizeof(TPMSStream));
+    instance->ring = malloc(TPMS_STREAM_RING_SIZE * sizeof(TPMSStreamEvent));
+    instance->head = 0;
+    instance->tail = 0;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->enabled = false;
+    instance->seq = 0;
+    instance->device_id = tpms_stream_device_id();
+    instance->serial = NULL;
+
+    instance->thread = furi_thread_alloc_ex("TPMSStream", 1024, tpms_stream_worker, instance);
+    furi_thread_set_priority(instance->thread, FuriThreadPriorityLow);
+    furi_thread_start(instance->thread);
+    instance->running = true;
+    return instance;
+}
+
+void tpms_stream_free(TPMSStream* instance) {
+    furi_assert(instance);
+    if(instance->running) {
+        furi_thread_flags_set(furi_thread_get_id(instance->thread), TPMS_STREAM_FLAG_EXIT);
+        furi_thread_join(instance->thread);
+        instance->running = false;
+    }
+    furi_thread_free(instance->thread);
+    furi_mutex_free(instance->mutex);
+    free(instance->ring);
+    free(instance);
+}
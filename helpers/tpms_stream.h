@@ -0,0 +1,67 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/protocols/base.h>
+#include <lib/subghz/types.h>
+
+#include "tpms_session_log.h"
+
+typedef struct TPMSStream TPMSStream;
+
+/** One wire event, packed little-endian. The payload reuses the session
+ *  log record so a collector parses both with the same struct; magic,
+ *  device id and sequence number frame it for resync and gap detection
+ *  across several units */
+typedef struct __attribute__((packed)) {
+    uint8_t magic[2]; // "TS"
+    uint8_t version;
+    uint8_t reserved;
+    uint32_t device_id; // from the MCU unique id
+    uint32_t seq; // gaps reveal drops on the collector
+    TPMSSessionLogRecord record;
+    uint8_t crc; // CRC8 poly 0x07 over everything before it
+} TPMSStreamEvent;
+
+#define TPMS_STREAM_EVENT_VERSION 1
+
+/** Allocate TPMSStream and start its sender thread. The serial port is
+ *  untouched until tpms_stream_set_enabled()
+ *
+ * @return TPMSStream*
+ */
+TPMSStream* tpms_stream_alloc(void);
+
+/** Flush pending events, release the serial port and free TPMSStream
+ *
+ * @param instance - TPMSStream instance
+ */
+void tpms_stream_free(TPMSStream* instance);
+
+/** Enable or disable streaming. Enabling acquires LPUART and starts
+ *  emitting events, disabling releases it; both happen on the sender
+ *  thread
+ *
+ * @param instance - TPMSStream instance
+ * @param enabled - stream decoded frames when true
+ */
+void tpms_stream_set_enabled(TPMSStream* instance, bool enabled);
+
+/** Get whether streaming is enabled
+ *
+ * @param instance - TPMSStream instance
+ * @return bool - streaming enabled
+ */
+bool tpms_stream_get_enabled(TPMSStream* instance);
+
+/** Emit one decoded frame. Fire-and-forget: copies the event into the
+ *  RAM ring and returns, the sender thread puts it on the wire. A full
+ *  ring drops the oldest pending event, never the decode path
+ *
+ * @param instance - TPMSStream instance
+ * @param decoder_base - decoder that produced the frame
+ * @param preset - radio preset the frame was received with
+ */
+void tpms_stream_push(
+    TPMSStream* instance,
+    SubGhzProtocolDecoderBase* decoder_base,
+    SubGhzRadioPreset* preset);
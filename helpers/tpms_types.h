@@ -37,6 +37,8 @@ typedef enum {
     TPMSViewReceiver,
     TPMSViewReceiverInfo,
     TPMSViewWidget,
+    TPMSViewTextInput,
+    TPMSViewSweep,
 } TPMSView;
 
 /** TPMSTxRx state */
@@ -52,7 +54,10 @@ typedef enum {
     TPMSRelearnOn,
 } TPMSRelearn;
 
+/** LF wake pattern families, indexes into the relearn pattern table */
 typedef enum {
-    TPMSRelearnTypeCommon,
-    //TPMSRelearnAnotherOEM,
+    TPMSRelearnTypeCommon, // plain carrier
+    TPMSRelearnTypeSchrader,
+    TPMSRelearnTypeGmFord,
+    TPMSRelearnTypeAsian, // Toyota/Nissan/Hyundai
 } TPMSRelearnType;
\ No newline at end of file
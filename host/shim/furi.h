@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * Host-build shim for <furi.h>. Provides just enough of the firmware
+ * core API for the protocol translation units to compile natively; see
+ * host/README.md. Implementations of the non-macro pieces live in
+ * host/shim_stubs.c.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define furi_assert(x) assert(x)
+#define furi_check(x) assert(x)
+#define furi_crash(msg) (fprintf(stderr, "furi_crash: %s\n", (const char*)(msg)), abort())
+
+#define UNUSED(x) (void)(x)
+#define COUNT_OF(array) (sizeof(array) / sizeof((array)[0]))
+
+#ifndef MIN
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+// Errors and warnings go to stderr, info/debug chatter is swallowed so
+// the benchmark's timed loops are not dominated by terminal I/O. All
+// four levels run through real variadic sinks: the firmware's
+// target-width format strings stay out of the host's -Wformat, and
+// variables that only feed dropped log lines still count as used
+void furi_log_print(char level, const char* tag, const char* fmt, ...);
+void furi_log_drop(const char* tag, const char* fmt, ...);
+
+#define FURI_LOG_E(tag, fmt, ...) furi_log_print('E', tag, fmt, ##__VA_ARGS__)
+#define FURI_LOG_W(tag, fmt, ...) furi_log_print('W', tag, fmt, ##__VA_ARGS__)
+#define FURI_LOG_I(tag, fmt, ...) furi_log_drop(tag, fmt, ##__VA_ARGS__)
+#define FURI_LOG_D(tag, fmt, ...) furi_log_drop(tag, fmt, ##__VA_ARGS__)
+
+/** Milliseconds since an arbitrary epoch, CLOCK_MONOTONIC on the host */
+uint32_t furi_get_tick(void);
+
+typedef struct FuriString FuriString;
+
+FuriString* furi_string_alloc(void);
+void furi_string_free(FuriString* string);
+void furi_string_reset(FuriString* string);
+const char* furi_string_get_cstr(const FuriString* string);
+void furi_string_set(FuriString* string, const char* text);
+void furi_string_set_str(FuriString* string, const char* text);
+// No printf format attribute here: the firmware's format strings use
+// %lu/%lX for uint32_t, correct on the 32-bit target but flagged by
+// -Wformat on hosts where long is 64-bit
+void furi_string_printf(FuriString* string, const char* format, ...);
+void furi_string_cat_printf(FuriString* string, const char* format, ...);
+
+#define RECORD_STORAGE "storage"
+void* furi_record_open(const char* name);
+void furi_record_close(const char* name);
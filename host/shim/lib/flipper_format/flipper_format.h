@@ -0,0 +1,5 @@
+#pragma once
+
+// Host-build shim: FlipperFormat stays opaque, the serialize paths that
+// would use it are stubbed out in host/shim_stubs.c
+typedef struct FlipperFormat FlipperFormat;
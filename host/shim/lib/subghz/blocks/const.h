@@ -0,0 +1,12 @@
+#pragma once
+
+// Host-build shim for <lib/subghz/blocks/const.h>
+
+#include <furi.h>
+
+typedef struct {
+    uint32_t te_short;
+    uint32_t te_long;
+    uint32_t te_delta;
+    uint32_t min_count_bit_for_found;
+} SubGhzBlockConst;
@@ -0,0 +1,13 @@
+#pragma once
+
+// Host-build shim for <lib/subghz/blocks/encoder.h>; only the struct
+// layout is needed, no encoder runs on the host
+
+#include <lib/subghz/types.h>
+
+typedef struct {
+    size_t repeat;
+    size_t front;
+    size_t size_upload;
+    LevelDuration* upload;
+} SubGhzProtocolBlockEncoder;
@@ -0,0 +1,5 @@
+#pragma once
+
+// Host-build shim for <lib/subghz/blocks/math.h>
+
+#define DURATION_DIFF(x, y) (((x) < (y)) ? ((y) - (x)) : ((x) - (y)))
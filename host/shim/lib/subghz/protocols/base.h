@@ -0,0 +1,23 @@
+#pragma once
+
+// Host-build shim for <lib/subghz/protocols/base.h>
+
+#include <lib/subghz/types.h>
+
+typedef struct SubGhzProtocolDecoderBase SubGhzProtocolDecoderBase;
+
+typedef void (
+    *SubGhzProtocolDecoderBaseRxCallback)(SubGhzProtocolDecoderBase* instance, void* context);
+
+struct SubGhzProtocolDecoderBase {
+    // Decoder general section
+    const SubGhzProtocol* protocol;
+
+    // Callback section
+    SubGhzProtocolDecoderBaseRxCallback callback;
+    void* context;
+};
+
+typedef struct {
+    const SubGhzProtocol* protocol;
+} SubGhzProtocolEncoderBase;
@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * Host-build shim for <lib/subghz/types.h>. Struct layouts mirror the
+ * firmware definitions the decoders were written against; only the
+ * members the protocol translation units actually touch matter here.
+ */
+
+#include <furi.h>
+#include <lib/flipper_format/flipper_format.h>
+
+typedef struct SubGhzEnvironment SubGhzEnvironment;
+
+typedef enum {
+    SubGhzProtocolStatusOk = 0,
+    SubGhzProtocolStatusError = (-1),
+    SubGhzProtocolStatusErrorParserHeader = (-2),
+    SubGhzProtocolStatusErrorParserFrequency = (-3),
+    SubGhzProtocolStatusErrorParserPreset = (-4),
+    SubGhzProtocolStatusErrorParserCustomPreset = (-5),
+    SubGhzProtocolStatusErrorParserProtocolName = (-6),
+    SubGhzProtocolStatusErrorParserBitCount = (-7),
+    SubGhzProtocolStatusErrorParserKey = (-8),
+    SubGhzProtocolStatusErrorParserTe = (-9),
+    SubGhzProtocolStatusErrorParserOthers = (-10),
+    SubGhzProtocolStatusErrorValueBitCount = (-11),
+    SubGhzProtocolStatusErrorEncoderGetUpload = (-12),
+    SubGhzProtocolStatusReserved = 0x7FFFFFFF,
+} SubGhzProtocolStatus;
+
+typedef struct {
+    FuriString* name;
+    uint32_t frequency;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzRadioPreset;
+
+typedef enum {
+    SubGhzProtocolTypeUnknown = 0,
+    SubGhzProtocolTypeStatic,
+    SubGhzProtocolTypeDynamic,
+    SubGhzProtocolTypeRAW,
+    SubGhzProtocolWeatherStation,
+    SubGhzProtocolCustom,
+    SubGhzProtocolTypeBinRAW,
+} SubGhzProtocolType;
+
+typedef enum {
+    SubGhzProtocolFlag_RAW = (1 << 0),
+    SubGhzProtocolFlag_Decodable = (1 << 1),
+    SubGhzProtocolFlag_315 = (1 << 2),
+    SubGhzProtocolFlag_433 = (1 << 3),
+    SubGhzProtocolFlag_868 = (1 << 4),
+    SubGhzProtocolFlag_AM = (1 << 5),
+    SubGhzProtocolFlag_FM = (1 << 6),
+    SubGhzProtocolFlag_Save = (1 << 7),
+    SubGhzProtocolFlag_Load = (1 << 8),
+    SubGhzProtocolFlag_Send = (1 << 9),
+    SubGhzProtocolFlag_BinRAW = (1 << 10),
+} SubGhzProtocolFlag;
+
+typedef void* (*SubGhzAlloc)(SubGhzEnvironment* environment);
+typedef void (*SubGhzFree)(void* context);
+typedef void (*SubGhzDecoderFeed)(void* decoder, bool level, uint32_t duration);
+typedef void (*SubGhzDecoderReset)(void* decoder);
+typedef uint8_t (*SubGhzGetHashData)(void* decoder);
+typedef SubGhzProtocolStatus (
+    *SubGhzSerialize)(void* decoder, FlipperFormat* flipper_format, SubGhzRadioPreset* preset);
+typedef SubGhzProtocolStatus (*SubGhzDeserialize)(void* decoder, FlipperFormat* flipper_format);
+typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
+
+typedef void (*SubGhzEncoderStop)(void* encoder);
+typedef struct {
+    uint32_t duration;
+    bool level;
+} LevelDuration;
+typedef LevelDuration (*SubGhzEncoderYield)(void* context);
+
+typedef struct {
+    SubGhzAlloc alloc;
+    SubGhzFree free;
+
+    SubGhzDecoderFeed feed;
+    SubGhzDecoderReset reset;
+
+    SubGhzGetHashData get_hash_data;
+    SubGhzSerialize serialize;
+    SubGhzDeserialize deserialize;
+    SubGhzGetString get_string;
+} SubGhzProtocolDecoder;
+
+typedef struct {
+    SubGhzAlloc alloc;
+    SubGhzFree free;
+
+    SubGhzDeserialize deserialize;
+    SubGhzEncoderStop stop;
+    SubGhzEncoderYield yield;
+} SubGhzProtocolEncoder;
+
+typedef struct {
+    const char* name;
+    SubGhzProtocolType type;
+    SubGhzProtocolFlag flag;
+
+    const SubGhzProtocolEncoder* encoder;
+    const SubGhzProtocolDecoder* decoder;
+} SubGhzProtocol;
@@ -0,0 +1,29 @@
+#pragma once
+
+// Host-build shim for <lib/toolbox/manchester_decoder.h>. Enum values
+// match the firmware toolbox: events are spaced so event/2 indexes the
+// packed transition table. manchester_advance() lives in
+// host/shim_stubs.c with the same semantics as the firmware version.
+
+#include <furi.h>
+
+typedef enum {
+    ManchesterStateStart1 = 0,
+    ManchesterStateMid1 = 1,
+    ManchesterStateMid0 = 2,
+    ManchesterStateStart0 = 3,
+} ManchesterState;
+
+typedef enum {
+    ManchesterEventShortLow = 0,
+    ManchesterEventShortHigh = 2,
+    ManchesterEventLongLow = 4,
+    ManchesterEventLongHigh = 6,
+    ManchesterEventReset = 8,
+} ManchesterEvent;
+
+bool manchester_advance(
+    ManchesterState state,
+    ManchesterEvent event,
+    ManchesterState* next_state,
+    bool* data);
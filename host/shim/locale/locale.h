@@ -0,0 +1,3 @@
+#pragma once
+
+// Host-build shim: the locale helpers are only used by the on-device UI
@@ -0,0 +1,267 @@
+/**
+ * Host implementations of the firmware APIs the protocol translation
+ * units link against. Behavioural pieces (Manchester stepper, block
+ * decoder helpers) mirror the firmware versions exactly — any
+ * divergence would make the benchmark lie about on-device decoding.
+ * Storage is stubbed: opens fail, so persisted state keeps its
+ * in-memory defaults.
+ */
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <lib/subghz/blocks/decoder.h>
+#include <lib/toolbox/manchester_decoder.h>
+#include <protocols/tpms_generic.h>
+
+#include <stdarg.h>
+#include <time.h>
+
+uint32_t furi_get_tick(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+void furi_log_print(char level, const char* tag, const char* fmt, ...) {
+    va_list args;
+    fprintf(stderr, "[%c][%s] ", level, tag);
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+void furi_log_drop(const char* tag, const char* fmt, ...) {
+    (void)tag;
+    (void)fmt;
+}
+
+struct FuriString {
+    char* str;
+    size_t size; // strlen, not capacity
+};
+
+FuriString* furi_string_alloc(void) {
+    FuriString* string = malloc(sizeof(FuriString));
+    string->str = strdup("");
+    string->size = 0;
+    return string;
+}
+
+void furi_string_free(FuriString* string) {
+    free(string->str);
+    free(string);
+}
+
+void furi_string_reset(FuriString* string) {
+    furi_string_set(string, "");
+}
+
+const char* furi_string_get_cstr(const FuriString* string) {
+    return string->str;
+}
+
+void furi_string_set(FuriString* string, const char* text) {
+    free(string->str);
+    string->str = strdup(text);
+    string->size = strlen(text);
+}
+
+void furi_string_set_str(FuriString* string, const char* text) {
+    furi_string_set(string, text);
+}
+
+static void furi_string_vprintf_at(FuriString* string, size_t at, const char* format, va_list args) {
+    va_list measure;
+    va_copy(measure, args);
+    int len = vsnprintf(NULL, 0, format, measure);
+    va_end(measure);
+    if(len < 0) return;
+
+    char* str = malloc(at + len + 1);
+    memcpy(str, string->str, at);
+    vsnprintf(str + at, len + 1, format, args);
+    free(string->str);
+    string->str = str;
+    string->size = at + len;
+}
+
+void furi_string_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    furi_string_vprintf_at(string, 0, format, args);
+    va_end(args);
+}
+
+void furi_string_cat_printf(FuriString* string, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    furi_string_vprintf_at(string, string->size, format, args);
+    va_end(args);
+}
+
+void* furi_record_open(const char* name) {
+    UNUSED(name);
+    return NULL;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+// --- storage: no SD card on the host ---
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    return NULL;
+}
+
+void storage_file_free(File* file) {
+    UNUSED(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    UNUSED(file);
+    UNUSED(path);
+    UNUSED(access_mode);
+    UNUSED(open_mode);
+    return false;
+}
+
+bool storage_file_close(File* file) {
+    UNUSED(file);
+    return true;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    UNUSED(file);
+    UNUSED(buff);
+    UNUSED(bytes_to_read);
+    return 0;
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    UNUSED(file);
+    UNUSED(buff);
+    UNUSED(bytes_to_write);
+    return 0;
+}
+
+uint64_t storage_file_size(File* file) {
+    UNUSED(file);
+    return 0;
+}
+
+bool storage_common_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    UNUSED(path);
+    return false;
+}
+
+// --- subghz block decoder helpers, same as firmware ---
+
+void subghz_protocol_blocks_add_bit(SubGhzBlockDecoder* decoder, uint8_t bit) {
+    decoder->decode_data = decoder->decode_data << 1 | bit;
+    decoder->decode_count_bit++;
+}
+
+uint8_t subghz_protocol_blocks_get_hash_data(SubGhzBlockDecoder* decoder, size_t len) {
+    uint8_t hash = 0;
+    uint8_t* p = (uint8_t*)&decoder->decode_data;
+    for(size_t i = 0; i < len; i++) {
+        hash ^= p[i];
+    }
+    return hash;
+}
+
+// --- generic block serialization: FlipperFormat does not exist on the
+// host and the benchmark reads decoded fields straight from the generic
+// block, so the serialize entry points just report failure ---
+
+void tpms_block_generic_get_preset_name(const char* preset_name, FuriString* preset_str) {
+    furi_string_set(preset_str, preset_name);
+}
+
+// Fixed-point renderer, same as the firmware one in tpms_generic.c; the
+// get_string entry points the decoders carry along link against it
+void tpms_format_fixed(char* output, size_t output_size, int32_t value, uint32_t scale) {
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-value) : (uint32_t)value;
+    int width = (scale >= 1000) ? 3 : (scale >= 100) ? 2 : 1;
+    snprintf(
+        output,
+        output_size,
+        "%s%lu.%0*lu",
+        (value < 0) ? "-" : "",
+        (unsigned long)(magnitude / scale),
+        width,
+        (unsigned long)(magnitude % scale));
+}
+
+SubGhzProtocolStatus tpms_block_generic_serialize(
+    TPMSBlockGeneric* instance,
+    FlipperFormat* flipper_format,
+    SubGhzRadioPreset* preset) {
+    UNUSED(instance);
+    UNUSED(flipper_format);
+    UNUSED(preset);
+    return SubGhzProtocolStatusError;
+}
+
+SubGhzProtocolStatus
+    tpms_block_generic_deserialize(TPMSBlockGeneric* instance, FlipperFormat* flipper_format) {
+    UNUSED(instance);
+    UNUSED(flipper_format);
+    return SubGhzProtocolStatusError;
+}
+
+SubGhzProtocolStatus tpms_block_generic_deserialize_check_count_bit(
+    TPMSBlockGeneric* instance,
+    FlipperFormat* flipper_format,
+    uint16_t count_bit) {
+    UNUSED(instance);
+    UNUSED(flipper_format);
+    UNUSED(count_bit);
+    return SubGhzProtocolStatusError;
+}
+
+// --- toolbox Manchester stepper, same transition table as firmware ---
+
+static const uint8_t manchester_transitions[] = {
+    0b00000001,
+    0b10010001,
+    0b10011011,
+    0b11111011,
+};
+
+bool manchester_advance(
+    ManchesterState state,
+    ManchesterEvent event,
+    ManchesterState* next_state,
+    bool* data) {
+    bool result = false;
+    ManchesterState new_state;
+
+    if(event == ManchesterEventReset) {
+        new_state = ManchesterStateMid1;
+    } else {
+        new_state = (manchester_transitions[state] >> event) & 0x3;
+        if(new_state == state) {
+            new_state = ManchesterStateMid1;
+        } else {
+            if(new_state == ManchesterStateMid0) {
+                if(data) *data = false;
+                result = true;
+            } else if(new_state == ManchesterStateMid1) {
+                if(data) *data = true;
+                result = true;
+            }
+        }
+    }
+
+    *next_state = new_state;
+    return result;
+}
@@ -0,0 +1,250 @@
+/**
+ * Host-side decoder benchmark. Compiles the six protocol decoders
+ * natively (see the Makefile and the shim headers), replays each
+ * protocol's golden edge stream from tpms_benchmark_streams.c through
+ * its feed loop and reports ns/edge and decodes/sec. Decoded fields are
+ * checked against host/golden.json so a decoder change that alters
+ * timing OR output shows up in CI; --write-golden regenerates the file
+ * after an intentional change.
+ *
+ * Usage:
+ *   tpms_bench                 run benchmark, verify against golden.json
+ *   tpms_bench --write-golden  run once and rewrite golden.json
+ */
+
+#include <furi.h>
+#include <protocols/tpms_benchmark_streams.h>
+#include <protocols/tpms_decoder_stats.h>
+#include <protocols/tpms_protocol_profile.h>
+#include <protocols/schrader_gg4.h>
+#include <protocols/toyota_tpms.h>
+#include <protocols/ford_tpms.h>
+#include <protocols/gm_tpms.h>
+#include <protocols/nissan_tpms.h>
+#include <protocols/hyundai_tpms.h>
+
+#include <math.h>
+#include <time.h>
+
+#define TPMS_BENCH_MAX_EDGES 1024
+// Timed window per protocol, long enough for a stable rate
+#define TPMS_BENCH_SLICE_NS 250000000LL
+#define TPMS_BENCH_GOLDEN_PATH "golden.json"
+// Float fields are printed with two decimals, match with a hair of slack
+#define TPMS_BENCH_FIELD_TOLERANCE 0.011
+
+typedef const TPMSBlockGeneric* (*TPMSBenchGetGeneric)(void* context);
+
+typedef struct {
+    const SubGhzProtocol* protocol;
+    TPMSDecoderStatsProtocol slot;
+    TPMSBenchGetGeneric get_generic;
+} TPMSBenchProtocol;
+
+static const TPMSBenchProtocol tpms_bench_protocols[] = {
+    {&tpms_protocol_schrader_gg4,
+     TPMSDecoderStatsProtocolSchrader,
+     tpms_protocol_decoder_schrader_gg4_get_generic},
+    {&tpms_protocol_toyota, TPMSDecoderStatsProtocolToyota, tpms_protocol_decoder_toyota_get_generic},
+    {&tpms_protocol_ford, TPMSDecoderStatsProtocolFord, tpms_protocol_decoder_ford_get_generic},
+    {&tpms_protocol_gm, TPMSDecoderStatsProtocolGm, tpms_protocol_decoder_gm_get_generic},
+    {&tpms_protocol_nissan, TPMSDecoderStatsProtocolNissan, tpms_protocol_decoder_nissan_get_generic},
+    {&tpms_protocol_hyundai,
+     TPMSDecoderStatsProtocolHyundai,
+     tpms_protocol_decoder_hyundai_get_generic},
+};
+
+#define TPMS_BENCH_PROTOCOL_COUNT COUNT_OF(tpms_bench_protocols)
+
+typedef struct {
+    const char* name;
+    uint64_t ns_per_edge;
+    uint64_t decodes_per_sec;
+    uint32_t decoded;
+    // Fields of the last decoded frame
+    uint32_t id;
+    double pressure;
+    double temperature;
+} TPMSBenchResult;
+
+static uint32_t tpms_bench_decoded;
+
+static void tpms_bench_rx_callback(SubGhzProtocolDecoderBase* instance, void* context) {
+    UNUSED(instance);
+    UNUSED(context);
+    tpms_bench_decoded++;
+}
+
+static int64_t tpms_bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void tpms_bench_run(const TPMSBenchProtocol* bench, TPMSBenchResult* result) {
+    uint32_t edges[TPMS_BENCH_MAX_EDGES];
+    size_t count = tpms_benchmark_stream_build(bench->slot, edges, TPMS_BENCH_MAX_EDGES);
+
+    result->name = bench->protocol->name;
+    if(!count) {
+        fprintf(stderr, "no golden stream for %s\n", bench->protocol->name);
+        return;
+    }
+
+    void* decoder = bench->protocol->decoder->alloc(NULL);
+    SubGhzProtocolDecoderBase* base = decoder;
+    base->callback = tpms_bench_rx_callback;
+    base->context = NULL;
+    bench->protocol->decoder->reset(decoder);
+
+    // Warm-up pass settles caches and the branch predictor
+    tpms_bench_decoded = 0;
+    for(size_t i = 0; i < count; i++) {
+        bench->protocol->decoder->feed(
+            decoder,
+            (edges[i] & TPMS_BENCHMARK_EDGE_LEVEL_BIT) != 0,
+            edges[i] & ~TPMS_BENCHMARK_EDGE_LEVEL_BIT);
+    }
+    if(!tpms_bench_decoded) {
+        fprintf(stderr, "%s did not decode its own golden stream\n", bench->protocol->name);
+        bench->protocol->decoder->free(decoder);
+        return;
+    }
+
+    tpms_bench_decoded = 0;
+    uint64_t fed = 0;
+    int64_t start = tpms_bench_now_ns();
+    int64_t elapsed;
+    do {
+        for(size_t i = 0; i < count; i++) {
+            bench->protocol->decoder->feed(
+                decoder,
+                (edges[i] & TPMS_BENCHMARK_EDGE_LEVEL_BIT) != 0,
+                edges[i] & ~TPMS_BENCHMARK_EDGE_LEVEL_BIT);
+        }
+        fed += count;
+        elapsed = tpms_bench_now_ns() - start;
+    } while(elapsed < TPMS_BENCH_SLICE_NS);
+
+    result->ns_per_edge = (uint64_t)(elapsed / (int64_t)fed);
+    result->decodes_per_sec = (uint64_t)((tpms_bench_decoded * 1000000000ULL) / (uint64_t)elapsed);
+    result->decoded = tpms_bench_decoded;
+
+    const TPMSBlockGeneric* generic = bench->get_generic(decoder);
+    result->id = generic->id;
+    result->pressure = generic->pressure_mb / 1000.0;
+    result->temperature = generic->temperature_dc / 10.0;
+
+    bench->protocol->decoder->free(decoder);
+}
+
+static void tpms_bench_print_json(FILE* out, const TPMSBenchResult* results, size_t count) {
+    fprintf(out, "[\n");
+    for(size_t i = 0; i < count; i++) {
+        const TPMSBenchResult* r = &results[i];
+        fprintf(
+            out,
+            "  {\"protocol\": \"%s\", \"id\": \"0x%08X\", \"pressure\": %.2f, "
+            "\"temperature\": %.2f}%s\n",
+            r->name,
+            r->id,
+            r->pressure,
+            r->temperature,
+            (i + 1 < count) ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+static int tpms_bench_check_golden(const TPMSBenchResult* results, size_t count) {
+    FILE* golden = fopen(TPMS_BENCH_GOLDEN_PATH, "r");
+    if(!golden) {
+        fprintf(
+            stderr,
+            "%s missing, run with --write-golden to create it\n",
+            TPMS_BENCH_GOLDEN_PATH);
+        return 1;
+    }
+
+    int failures = 0;
+    size_t matched = 0;
+    char line[256];
+    while(fgets(line, sizeof(line), golden)) {
+        char name[64];
+        unsigned int id;
+        double pressure, temperature;
+        if(sscanf(
+               line,
+               " {\"protocol\": \"%63[^\"]\", \"id\": \"0x%x\", \"pressure\": %lf, "
+               "\"temperature\": %lf}",
+               name,
+               &id,
+               &pressure,
+               &temperature) != 4) {
+            continue;
+        }
+        for(size_t i = 0; i < count; i++) {
+            if(strcmp(results[i].name, name) != 0) continue;
+            matched++;
+            if(results[i].id != id ||
+               fabs(results[i].pressure - pressure) > TPMS_BENCH_FIELD_TOLERANCE ||
+               fabs(results[i].temperature - temperature) > TPMS_BENCH_FIELD_TOLERANCE) {
+                fprintf(
+                    stderr,
+                    "MISMATCH %s: got id=0x%08X p=%.2f t=%.2f, "
+                    "golden id=0x%08X p=%.2f t=%.2f\n",
+                    name,
+                    results[i].id,
+                    results[i].pressure,
+                    results[i].temperature,
+                    id,
+                    pressure,
+                    temperature);
+                failures++;
+            }
+            break;
+        }
+    }
+    fclose(golden);
+
+    if(matched != count) {
+        fprintf(stderr, "golden file covers %zu of %zu protocols\n", matched, count);
+        failures++;
+    }
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    bool write_golden = (argc > 1) && (strcmp(argv[1], "--write-golden") == 0);
+
+    TPMSBenchResult results[TPMS_BENCH_PROTOCOL_COUNT] = {0};
+    int broken = 0;
+
+    printf("%-16s %12s %14s\n", "protocol", "ns/edge", "decodes/sec");
+    for(size_t i = 0; i < TPMS_BENCH_PROTOCOL_COUNT; i++) {
+        tpms_bench_run(&tpms_bench_protocols[i], &results[i]);
+        if(!results[i].decoded) {
+            broken++;
+            continue;
+        }
+        printf(
+            "%-16s %12llu %14llu\n",
+            results[i].name,
+            (unsigned long long)results[i].ns_per_edge,
+            (unsigned long long)results[i].decodes_per_sec);
+    }
+    if(broken) return 1;
+
+    if(write_golden) {
+        FILE* golden = fopen(TPMS_BENCH_GOLDEN_PATH, "w");
+        if(!golden) {
+            fprintf(stderr, "cannot write %s\n", TPMS_BENCH_GOLDEN_PATH);
+            return 1;
+        }
+        tpms_bench_print_json(golden, results, TPMS_BENCH_PROTOCOL_COUNT);
+        fclose(golden);
+        printf("wrote %s\n", TPMS_BENCH_GOLDEN_PATH);
+        return 0;
+    }
+
+    return tpms_bench_check_golden(results, TPMS_BENCH_PROTOCOL_COUNT);
+}
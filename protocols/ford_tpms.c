@@ -1,5 +1,10 @@
+#include "tpms_protocol_profile.h"
+#if TPMS_PROTOCOL_ENABLE_FORD
+
 #include "ford_tpms.h"
-#include <lib/toolbox/manchester_decoder.h>
+#include "tpms_decoder_stats.h"
+#include "tpms_crc.h"
+#include "tpms_manchester.h"
 
 #define TAG "Ford TPMS"
 
@@ -30,7 +35,7 @@
 #define FORD_SYNC_PATTERN_1 0xaa
 #define FORD_SYNC_PATTERN_2 0xa9
 
-static const SubGhzBlockConst tpms_protocol_ford_const = {
+const SubGhzBlockConst tpms_protocol_ford_const = {
     .te_short = 52,     // FSK bit period ~52us
     .te_long = 52,      // Same for FSK
     .te_delta = 15,     // Tolerance
@@ -108,11 +113,7 @@ void tpms_protocol_decoder_ford_reset(void* context) {
 
 static bool tpms_protocol_ford_check_checksum(uint8_t* data) {
     // Simple sum checksum: sum of bytes 0-6 should equal byte 7
-    uint8_t checksum = 0;
-    for(int i = 0; i < 7; i++) {
-        checksum += data[i];
-    }
-    return (checksum & 0xff) == data[7];
+    return tpms_checksum8(data, 7) == data[7];
 }
 
 static void tpms_protocol_ford_analyze(TPMSBlockGeneric* instance, uint8_t* data) {
@@ -127,15 +128,15 @@ static void tpms_protocol_ford_analyze(TPMSBlockGeneric* instance, uint8_t* data
     if(data[6] & 0x20) { // 9th bit of pressure
         pressure_raw |= 0x100;
     }
-    float pressure_psi = pressure_raw * 0.25f;
-    instance->pressure = pressure_psi * 0.0689476f; // Convert PSI to bar
-    
+    // 0.25 PSI per count, 1 PSI = 68.948 millibar -> 17.237 mb per count
+    instance->pressure_mb = (int32_t)pressure_raw * 17237 / 1000;
+
     // Temperature calculation (when valid)
     bool temperature_valid = !(data[5] & 0x80);
     if(temperature_valid) {
-        instance->temperature = (data[5] & 0x7f) - 56.0f; // Offset by 56°C
+        instance->temperature_dc = (int16_t)(((data[5] & 0x7f) - 56) * 10); // Offset by 56°C
     } else {
-        instance->temperature = -1000.0f; // Invalid temperature marker
+        instance->temperature_dc = TPMS_TEMPERATURE_INVALID_DC;
     }
     
     // Status flags analysis
@@ -158,8 +159,9 @@ static void tpms_protocol_ford_analyze(TPMSBlockGeneric* instance, uint8_t* data
                      data[7];
     instance->data_count_bit = 64;
     
-    FURI_LOG_I(TAG, "Ford TPMS: ID=%08lX P=%.1f PSI T=%.0f°C Moving=%d Learn=%d", 
-        instance->id, pressure_psi, (double)instance->temperature, moving, learn);
+    FURI_LOG_I(TAG, "Ford TPMS: ID=%08lX P=%u.%02u PSI T=%d°C Moving=%d Learn=%d Rest=%d",
+        instance->id, pressure_raw / 4, (pressure_raw % 4) * 25,
+        instance->temperature_dc / 10, moving, learn, rest);
 }
 
 void tpms_protocol_decoder_ford_feed(void* context, bool level, uint32_t duration) {
@@ -190,6 +192,7 @@ void tpms_protocol_decoder_ford_feed(void* context, bool level, uint32_t duratio
                                          (instance->decoder.decode_count_bit - 16)) & 0xFFFF;
                     if(sync_check == 0xaaa9) {
                         FURI_LOG_D(TAG, "Ford sync found");
+                        tpms_decoder_stats_add(TPMSDecoderStatsProtocolFord, TPMSDecoderStatSyncs);
                         instance->decoder.parser_step = FordDecoderStepData;
                         instance->decoder.decode_data = 0;
                         instance->decoder.decode_count_bit = 0;
@@ -208,16 +211,23 @@ void tpms_protocol_decoder_ford_feed(void* context, bool level, uint32_t duratio
             break;
             
         case FordDecoderStepData:
-            // Collect Manchester encoded data
-            if(DURATION_DIFF(duration, tpms_protocol_ford_const.te_short) < 
-               tpms_protocol_ford_const.te_delta) {
-                
+            // Collect Manchester encoded data; two equal data bits merge
+            // their adjacent half-bits into one pulse of twice the period,
+            // so long durations are valid symbols here
+            if(DURATION_DIFF(duration, tpms_protocol_ford_const.te_short) <
+               tpms_protocol_ford_const.te_delta ||
+               DURATION_DIFF(duration, 2 * tpms_protocol_ford_const.te_short) <
+               2 * tpms_protocol_ford_const.te_delta) {
+                bool is_long = DURATION_DIFF(duration, tpms_protocol_ford_const.te_short) >=
+                               tpms_protocol_ford_const.te_delta;
+
                 // Use simplified Manchester decoding similar to other protocols
                 bool bit = false;
-                ManchesterEvent event = level ? ManchesterEventShortHigh : ManchesterEventShortLow;
+                ManchesterEvent event =
+                    level ? (is_long ? ManchesterEventLongHigh : ManchesterEventShortHigh) :
+                            (is_long ? ManchesterEventLongLow : ManchesterEventShortLow);
                 
-                if(manchester_advance(instance->manchester_state, event, 
-                                    &instance->manchester_state, &bit)) {
+                if(tpms_manchester_advance(&instance->manchester_state, event, &bit)) {
                     subghz_protocol_blocks_add_bit(&instance->decoder, bit);
                     
                     if(instance->decoder.decode_count_bit >= 
@@ -237,24 +247,37 @@ void tpms_protocol_decoder_ford_feed(void* context, bool level, uint32_t duratio
                         
                         if(tpms_protocol_ford_check_checksum(instance->manchester_data)) {
                             tpms_protocol_ford_analyze(&instance->generic, instance->manchester_data);
-                            
+                            tpms_decoder_stats_add(
+                                TPMSDecoderStatsProtocolFord, TPMSDecoderStatFrames);
+
                             if(instance->base.callback) {
                                 instance->base.callback(&instance->base, instance->base.context);
                             }
                         } else {
                             FURI_LOG_D(TAG, "Ford checksum failed");
+                            tpms_decoder_stats_add(
+                                TPMSDecoderStatsProtocolFord, TPMSDecoderStatCrcErrors);
                         }
                         
                         instance->decoder.parser_step = FordDecoderStepReset;
                     }
                 }
             } else {
+                if(instance->decoder.decode_count_bit) {
+                    tpms_decoder_stats_add(TPMSDecoderStatsProtocolFord, TPMSDecoderStatAborts);
+                }
                 instance->decoder.parser_step = FordDecoderStepReset;
             }
             break;
     }
 }
 
+const TPMSBlockGeneric* tpms_protocol_decoder_ford_get_generic(void* context) {
+    furi_assert(context);
+    TPMSProtocolDecoderFord* instance = context;
+    return &instance->generic;
+}
+
 uint8_t tpms_protocol_decoder_ford_get_hash_data(void* context) {
     furi_assert(context);
     TPMSProtocolDecoderFord* instance = context;
@@ -290,26 +313,29 @@ void tpms_protocol_decoder_ford_get_string(void* context, FuriString* output) {
     uint8_t flags = instance->generic.battery_low; // Repurposed field
     uint16_t pressure_raw = (instance->generic.data >> 32) & 0xFF;
     if(flags & 0x20) pressure_raw |= 0x100;
-    float pressure_psi = pressure_raw * 0.25f;
-    
+    char pressure_str[16];
+    tpms_format_fixed(pressure_str, sizeof(pressure_str), pressure_raw * 5 / 2, 10);
+
     // Determine mode
     const char* mode = "Rest";
     if((flags & 0x44) == 0x44) mode = "Moving";
     else if(flags & 0x08) mode = "Learn";
-    
-    bool temp_valid = instance->generic.temperature > -999.0f;
-    
+
+    bool temp_valid = instance->generic.temperature_dc != TPMS_TEMPERATURE_INVALID_DC;
+
     furi_string_printf(
         output,
         "%s\r\n"
         "Id:0x%08lX\r\n"
         "Mode:%s\r\n"
-        "Pressure:%.1f PSI\r\n"
-        "%s%.0f C",
+        "Pressure:%s PSI\r\n"
+        "%s%d C",
         instance->generic.protocol_name,
         instance->generic.id,
         mode,
-        (double)pressure_psi,
+        pressure_str,
         temp_valid ? "Temp:" : "Temp:N/A",
-        temp_valid ? (double)instance->generic.temperature : 0.0);
+        temp_valid ? instance->generic.temperature_dc / 10 : 0);
 }
+
+#endif // TPMS_PROTOCOL_ENABLE_FORD
@@ -15,6 +15,7 @@ typedef struct TPMSProtocolEncoderFord TPMSProtocolEncoderFord;
 extern const SubGhzProtocolDecoder tpms_protocol_ford_decoder;
 extern const SubGhzProtocolEncoder tpms_protocol_ford_encoder;
 extern const SubGhzProtocol tpms_protocol_ford;
+extern const SubGhzBlockConst tpms_protocol_ford_const;
 
 /**
  * Allocate TPMSProtocolDecoderFord.
@@ -50,6 +51,13 @@ void tpms_protocol_decoder_ford_feed(void* context, bool level, uint32_t duratio
  */
 uint8_t tpms_protocol_decoder_ford_get_hash_data(void* context);
 
+/**
+ * Get a direct pointer to the last decoded generic block, no serialization.
+ * @param context Pointer to a TPMSProtocolDecoderFord instance
+ * @return TPMSBlockGeneric* generic block
+ */
+const TPMSBlockGeneric* tpms_protocol_decoder_ford_get_generic(void* context);
+
 /**
  * Serialize data TPMSProtocolDecoderFord.
  * @param context Pointer to a TPMSProtocolDecoderFord instance
@@ -1,5 +1,12 @@
+#include "tpms_protocol_profile.h"
+#if TPMS_PROTOCOL_ENABLE_GM
+
 #include "gm_tpms.h"
-#include <lib/toolbox/manchester_decoder.h>
+#include "tpms_decoder_stats.h"
+#include "tpms_burst_combine.h"
+#include "tpms_timing_cal.h"
+#include "tpms_crc.h"
+#include "tpms_manchester.h"
 
 #define TAG "GM TPMS"
 
@@ -32,7 +39,7 @@
 #define GM_SYNC_PATTERN 0xD
 #define GM_PREAMBLE 0x555
 
-static const SubGhzBlockConst tpms_protocol_gm_const = {
+const SubGhzBlockConst tpms_protocol_gm_const = {
     .te_short = 100,    // Manchester bit period ~100us
     .te_long = 100,     // Same for FSK
     .te_delta = 20,     // Tolerance
@@ -88,22 +95,6 @@ const SubGhzProtocol tpms_protocol_gm = {
     .encoder = &tpms_protocol_gm_encoder,
 };
 
-// CRC-8 Dallas/Maxim calculation
-static uint8_t gm_crc8(uint8_t* data, size_t len) {
-    uint8_t crc = 0x00;
-    for(size_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for(int bit = 0; bit < 8; bit++) {
-            if(crc & 0x80) {
-                crc = (crc << 1) ^ 0x31;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
-}
-
 void* tpms_protocol_decoder_gm_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     TPMSProtocolDecoderGM* instance = malloc(sizeof(TPMSProtocolDecoderGM));
@@ -126,8 +117,8 @@ void tpms_protocol_decoder_gm_reset(void* context) {
 }
 
 static bool tpms_protocol_gm_check_crc(uint8_t* data) {
-    // CRC covers bytes 0-7, check against byte 8
-    uint8_t calc_crc = gm_crc8(data, 8);
+    // CRC-8 Dallas/Maxim covers bytes 0-7, check against byte 8
+    uint8_t calc_crc = tpms_crc8_0x31(data, 8, 0x00);
     return calc_crc == data[8];
 }
 
@@ -142,14 +133,13 @@ static void tpms_protocol_gm_analyze(TPMSBlockGeneric* instance, uint8_t* data)
     // Status/flags byte
     uint8_t status = data[6];
     
-    // Pressure calculation: kPa + 50 offset
+    // Pressure calculation: kPa + 50 offset, 1 kPa = 10 millibar
     uint8_t pressure_raw = data[7];
-    float pressure_kpa = pressure_raw - 50.0f;
-    instance->pressure = pressure_kpa * 0.01f; // Convert kPa to bar
-    
+    instance->pressure_mb = ((int32_t)pressure_raw - 50) * 10;
+
     // Temperature calculation: °C + 40 offset
     uint8_t temp_raw = data[8];
-    instance->temperature = temp_raw - 40.0f;
+    instance->temperature_dc = (int16_t)(((int32_t)temp_raw - 40) * 10);
     
     // Status analysis from flags
     bool fast_mode = (status & 0x80) == 0x80;  // Fast transmit mode
@@ -164,23 +154,29 @@ static void tpms_protocol_gm_analyze(TPMSBlockGeneric* instance, uint8_t* data)
     }
     instance->data_count_bit = 72;
     
-    FURI_LOG_I(TAG, "GM TPMS: ID=%08lX P=%.1f kPa T=%.0f°C Fast=%d Batt_Low=%d", 
-        instance->id, (double)pressure_kpa, (double)instance->temperature, fast_mode, battery_low);
+    FURI_LOG_I(TAG, "GM TPMS: ID=%08lX P=%ld kPa T=%d°C Fast=%d Batt_Low=%d",
+        instance->id, instance->pressure_mb / 10, instance->temperature_dc / 10,
+        fast_mode, battery_low);
 }
 
 void tpms_protocol_decoder_gm_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     TPMSProtocolDecoderGM* instance = context;
-    
+
+    // Shift by the learned site offset before any window comparison
+    duration = tpms_timing_cal_apply(TPMSDecoderStatsProtocolGm, duration);
+
     switch(instance->decoder.parser_step) {
         case GMDecoderStepReset:
             // Look for preamble (alternating pattern)
-            if(level && DURATION_DIFF(duration, tpms_protocol_gm_const.te_short) < 
+            if(level && DURATION_DIFF(duration, tpms_protocol_gm_const.te_short) <
                tpms_protocol_gm_const.te_delta) {
                 instance->decoder.parser_step = GMDecoderStepPreamble;
                 instance->decoder.decode_data = 0;
                 instance->decoder.decode_count_bit = 0;
                 instance->manchester_state = ManchesterStateStart1;
+                // Symbols of an attempt that fizzled out must not carry over
+                tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocolGm);
             }
             break;
             
@@ -196,6 +192,7 @@ void tpms_protocol_decoder_gm_feed(void* context, bool level, uint32_t duration)
                                       (instance->decoder.decode_count_bit - 16)) & 0xFFFF;
                     if(pattern == 0x555D) {
                         FURI_LOG_D(TAG, "GM preamble+sync found");
+                        tpms_decoder_stats_add(TPMSDecoderStatsProtocolGm, TPMSDecoderStatSyncs);
                         instance->decoder.parser_step = GMDecoderStepData;
                         instance->decoder.decode_data = 0;
                         instance->decoder.decode_count_bit = 0;
@@ -214,16 +211,28 @@ void tpms_protocol_decoder_gm_feed(void* context, bool level, uint32_t duration)
             break;
             
         case GMDecoderStepData:
-            // Collect Manchester encoded data
-            if(DURATION_DIFF(duration, tpms_protocol_gm_const.te_short) < 
-               tpms_protocol_gm_const.te_delta) {
-                
+            // Collect Manchester encoded data; two equal data bits merge
+            // their adjacent half-bits into one pulse of twice the period,
+            // so long durations are valid symbols here
+            if(DURATION_DIFF(duration, tpms_protocol_gm_const.te_short) <
+               tpms_protocol_gm_const.te_delta ||
+               DURATION_DIFF(duration, 2 * tpms_protocol_gm_const.te_short) <
+               2 * tpms_protocol_gm_const.te_delta) {
+                bool is_long = DURATION_DIFF(duration, tpms_protocol_gm_const.te_short) >=
+                               tpms_protocol_gm_const.te_delta;
+                tpms_timing_cal_note(
+                    TPMSDecoderStatsProtocolGm,
+                    (int32_t)duration -
+                        (int32_t)(is_long ? 2 * tpms_protocol_gm_const.te_short :
+                                            tpms_protocol_gm_const.te_short));
+
                 // Use simplified Manchester decoding
                 bool bit = false;
-                ManchesterEvent event = level ? ManchesterEventShortHigh : ManchesterEventShortLow;
+                ManchesterEvent event =
+                    level ? (is_long ? ManchesterEventLongHigh : ManchesterEventShortHigh) :
+                            (is_long ? ManchesterEventLongLow : ManchesterEventShortLow);
                 
-                if(manchester_advance(instance->manchester_state, event, 
-                                    &instance->manchester_state, &bit)) {
+                if(tpms_manchester_advance(&instance->manchester_state, event, &bit)) {
                     subghz_protocol_blocks_add_bit(&instance->decoder, bit);
                     
                     if(instance->decoder.decode_count_bit >= 
@@ -247,24 +256,66 @@ void tpms_protocol_decoder_gm_feed(void* context, bool level, uint32_t duration)
                         
                         if(tpms_protocol_gm_check_crc(instance->manchester_data)) {
                             tpms_protocol_gm_analyze(&instance->generic, instance->manchester_data);
-                            
+                            tpms_decoder_stats_add(
+                                TPMSDecoderStatsProtocolGm, TPMSDecoderStatFrames);
+                            tpms_burst_combine_clear(TPMSDecoderStatsProtocolGm);
+                            tpms_timing_cal_frame_good(TPMSDecoderStatsProtocolGm);
+
                             if(instance->base.callback) {
                                 instance->base.callback(&instance->base, instance->base.context);
                             }
                         } else {
                             FURI_LOG_D(TAG, "GM CRC failed");
+                            tpms_decoder_stats_add(
+                                TPMSDecoderStatsProtocolGm, TPMSDecoderStatCrcErrors);
+                            tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocolGm);
+                            // Each repetition of a weak burst tends to
+                            // corrupt a different bit, a majority vote
+                            // may still recover the frame
+                            uint64_t voted;
+                            if(tpms_burst_combine_push(
+                                   TPMSDecoderStatsProtocolGm,
+                                   instance->decoder.decode_data,
+                                   &voted)) {
+                                for(int i = 0; i < 7; i++) {
+                                    instance->manchester_data[i + 2] =
+                                        (voted >> ((6 - i) * 8)) & 0xFF;
+                                }
+                                if(tpms_protocol_gm_check_crc(instance->manchester_data)) {
+                                    FURI_LOG_I(TAG, "GM frame recovered by majority vote");
+                                    tpms_protocol_gm_analyze(
+                                        &instance->generic, instance->manchester_data);
+                                    tpms_decoder_stats_add(
+                                        TPMSDecoderStatsProtocolGm, TPMSDecoderStatFrames);
+                                    tpms_burst_combine_clear(TPMSDecoderStatsProtocolGm);
+                                    if(instance->base.callback) {
+                                        instance->base.callback(
+                                            &instance->base, instance->base.context);
+                                    }
+                                }
+                            }
                         }
                         
                         instance->decoder.parser_step = GMDecoderStepReset;
                     }
                 }
             } else {
+                if(instance->decoder.decode_count_bit) {
+                    tpms_decoder_stats_add(TPMSDecoderStatsProtocolGm, TPMSDecoderStatAborts);
+                }
+                tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocolGm);
                 instance->decoder.parser_step = GMDecoderStepReset;
             }
             break;
     }
 }
 
+const TPMSBlockGeneric* tpms_protocol_decoder_gm_get_generic(void* context) {
+    furi_assert(context);
+    TPMSProtocolDecoderGM* instance = context;
+    return &instance->generic;
+}
+
 uint8_t tpms_protocol_decoder_gm_get_hash_data(void* context) {
     furi_assert(context);
     TPMSProtocolDecoderGM* instance = context;
@@ -296,9 +347,10 @@ void tpms_protocol_decoder_gm_get_string(void* context, FuriString* output) {
     furi_assert(context);
     TPMSProtocolDecoderGM* instance = context;
     
-    // Calculate pressure in kPa from stored data
-    float pressure_kpa = instance->generic.pressure * 100.0f; // Convert bar back to kPa
-    
+    // Millibar is kPa * 10, so it renders as kPa with one decimal as-is
+    char pressure_str[16];
+    tpms_format_fixed(pressure_str, sizeof(pressure_str), instance->generic.pressure_mb, 10);
+
     // Determine mode from status flags (using battery_low field to store status)
     const char* mode = "Unknown";
     if(instance->generic.battery_low) {
@@ -306,17 +358,19 @@ void tpms_protocol_decoder_gm_get_string(void* context, FuriString* output) {
     } else {
         mode = "Normal";
     }
-    
+
     furi_string_printf(
         output,
         "%s\r\n"
         "Id:0x%08lX\r\n"
         "Mode:%s\r\n"
-        "Pressure:%.1f kPa\r\n"
-        "Temp:%.0f C",
+        "Pressure:%s kPa\r\n"
+        "Temp:%d C",
         instance->generic.protocol_name,
         instance->generic.id,
         mode,
-        (double)pressure_kpa,
-        (double)instance->generic.temperature);
+        pressure_str,
+        instance->generic.temperature_dc / 10);
 }
+
+#endif // TPMS_PROTOCOL_ENABLE_GM
@@ -15,6 +15,7 @@ typedef struct TPMSProtocolEncoderGM TPMSProtocolEncoderGM;
 extern const SubGhzProtocolDecoder tpms_protocol_gm_decoder;
 extern const SubGhzProtocolEncoder tpms_protocol_gm_encoder;
 extern const SubGhzProtocol tpms_protocol_gm;
+extern const SubGhzBlockConst tpms_protocol_gm_const;
 
 /**
  * Allocate TPMSProtocolDecoderGM.
@@ -50,6 +51,13 @@ void tpms_protocol_decoder_gm_feed(void* context, bool level, uint32_t duration)
  */
 uint8_t tpms_protocol_decoder_gm_get_hash_data(void* context);
 
+/**
+ * Get a direct pointer to the last decoded generic block, no serialization.
+ * @param context Pointer to a TPMSProtocolDecoderGM instance
+ * @return TPMSBlockGeneric* generic block
+ */
+const TPMSBlockGeneric* tpms_protocol_decoder_gm_get_generic(void* context);
+
 /**
  * Serialize data TPMSProtocolDecoderGM.
  * @param context Pointer to a TPMSProtocolDecoderGM instance
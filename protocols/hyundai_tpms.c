@@ -1,5 +1,10 @@
+#include "tpms_protocol_profile.h"
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+
 #include "hyundai_tpms.h"
-#include <lib/toolbox/manchester_decoder.h>
+#include "tpms_decoder_stats.h"
+#include "tpms_crc.h"
+#include "tpms_manchester.h"
 
 #define TAG "Hyundai TPMS"
 
@@ -33,7 +38,7 @@
 #define HYUNDAI_SYNC_PATTERN 0x56
 #define HYUNDAI_PREAMBLE 0x55555
 
-static const SubGhzBlockConst tpms_protocol_hyundai_const = {
+const SubGhzBlockConst tpms_protocol_hyundai_const = {
     .te_short = 50,     // Manchester bit period ~50us
     .te_long = 50,      // Same for FSK
     .te_delta = 15,     // Tolerance
@@ -88,22 +93,6 @@ const SubGhzProtocol tpms_protocol_hyundai = {
     .encoder = &tpms_protocol_hyundai_encoder,
 };
 
-// CRC-8 calculation (standard poly 0x31)
-static uint8_t hyundai_crc8(uint8_t* data, size_t len) {
-    uint8_t crc = 0x00;
-    for(size_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for(int bit = 0; bit < 8; bit++) {
-            if(crc & 0x80) {
-                crc = (crc << 1) ^ 0x31;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
-}
-
 void* tpms_protocol_decoder_hyundai_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     TPMSProtocolDecoderHyundai* instance = malloc(sizeof(TPMSProtocolDecoderHyundai));
@@ -126,8 +115,8 @@ void tpms_protocol_decoder_hyundai_reset(void* context) {
 }
 
 static bool tpms_protocol_hyundai_check_crc(uint8_t* data) {
-    // CRC covers bytes 0-8, check against byte 9
-    uint8_t calc_crc = hyundai_crc8(data, 9);
+    // CRC-8 poly 0x31 covers bytes 0-8, check against byte 9
+    uint8_t calc_crc = tpms_crc8_0x31(data, 9, 0x00);
     return calc_crc == data[9];
 }
 
@@ -142,15 +131,15 @@ static void tpms_protocol_hyundai_analyze(TPMSBlockGeneric* instance, uint8_t* d
     // Status byte
     uint8_t status = data[7];
     
-    // Pressure calculation: kPa + 40 offset
+    // Pressure calculation: kPa + 40 offset, 1 kPa = 10 millibar
     uint8_t pressure_raw = data[8];
-    float pressure_kpa = pressure_raw - 40.0f;
-    if(pressure_kpa < 0) pressure_kpa = 0; // Sanity check
-    instance->pressure = pressure_kpa * 0.01f; // Convert kPa to bar
-    
+    int32_t pressure_mb = ((int32_t)pressure_raw - 40) * 10;
+    if(pressure_mb < 0) pressure_mb = 0; // Sanity check
+    instance->pressure_mb = pressure_mb;
+
     // Temperature calculation: °C + 50 offset
     uint8_t temp_raw = data[9];
-    instance->temperature = temp_raw - 50.0f;
+    instance->temperature_dc = (int16_t)(((int32_t)temp_raw - 50) * 10);
     
     // Status analysis from flags
     bool fast_mode = (status & 0x80) == 0x80;    // Fast transmit mode
@@ -168,8 +157,8 @@ static void tpms_protocol_hyundai_analyze(TPMSBlockGeneric* instance, uint8_t* d
     }
     instance->data_count_bit = 80;
     
-    FURI_LOG_I(TAG, "Hyundai TPMS: ID=%08lX P=%.1f kPa T=%.0f°C Fast=%d Learn=%d Batt_Low=%d", 
-        instance->id, (double)pressure_kpa, (double)instance->temperature, 
+    FURI_LOG_I(TAG, "Hyundai TPMS: ID=%08lX P=%ld kPa T=%d°C Fast=%d Learn=%d Batt_Low=%d",
+        instance->id, instance->pressure_mb / 10, instance->temperature_dc / 10,
         fast_mode, learn_mode, battery_low);
 }
 
@@ -200,6 +189,8 @@ void tpms_protocol_decoder_hyundai_feed(void* context, bool level, uint32_t dura
                     uint32_t pattern = instance->decoder.decode_data & 0x0FFFFFFF;
                     if(pattern == 0x5555556) {
                         FURI_LOG_D(TAG, "Hyundai preamble+sync found");
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolHyundai, TPMSDecoderStatSyncs);
                         instance->decoder.parser_step = HyundaiDecoderStepData;
                         instance->decoder.decode_data = 0;
                         instance->decoder.decode_count_bit = 0;
@@ -218,16 +209,23 @@ void tpms_protocol_decoder_hyundai_feed(void* context, bool level, uint32_t dura
             break;
             
         case HyundaiDecoderStepData:
-            // Collect Manchester encoded data
-            if(DURATION_DIFF(duration, tpms_protocol_hyundai_const.te_short) < 
-               tpms_protocol_hyundai_const.te_delta) {
-                
+            // Collect Manchester encoded data; two equal data bits merge
+            // their adjacent half-bits into one pulse of twice the period,
+            // so long durations are valid symbols here
+            if(DURATION_DIFF(duration, tpms_protocol_hyundai_const.te_short) <
+               tpms_protocol_hyundai_const.te_delta ||
+               DURATION_DIFF(duration, 2 * tpms_protocol_hyundai_const.te_short) <
+               2 * tpms_protocol_hyundai_const.te_delta) {
+                bool is_long = DURATION_DIFF(duration, tpms_protocol_hyundai_const.te_short) >=
+                               tpms_protocol_hyundai_const.te_delta;
+
                 // Use simplified Manchester decoding
                 bool bit = false;
-                ManchesterEvent event = level ? ManchesterEventShortHigh : ManchesterEventShortLow;
+                ManchesterEvent event =
+                    level ? (is_long ? ManchesterEventLongHigh : ManchesterEventShortHigh) :
+                            (is_long ? ManchesterEventLongLow : ManchesterEventShortLow);
                 
-                if(manchester_advance(instance->manchester_state, event, 
-                                    &instance->manchester_state, &bit)) {
+                if(tpms_manchester_advance(&instance->manchester_state, event, &bit)) {
                     subghz_protocol_blocks_add_bit(&instance->decoder, bit);
                     
                     if(instance->decoder.decode_count_bit >= 
@@ -252,24 +250,37 @@ void tpms_protocol_decoder_hyundai_feed(void* context, bool level, uint32_t dura
                         
                         if(tpms_protocol_hyundai_check_crc(instance->manchester_data)) {
                             tpms_protocol_hyundai_analyze(&instance->generic, instance->manchester_data);
-                            
+                            tpms_decoder_stats_add(
+                                TPMSDecoderStatsProtocolHyundai, TPMSDecoderStatFrames);
+
                             if(instance->base.callback) {
                                 instance->base.callback(&instance->base, instance->base.context);
                             }
                         } else {
                             FURI_LOG_D(TAG, "Hyundai CRC failed");
+                            tpms_decoder_stats_add(
+                                TPMSDecoderStatsProtocolHyundai, TPMSDecoderStatCrcErrors);
                         }
                         
                         instance->decoder.parser_step = HyundaiDecoderStepReset;
                     }
                 }
             } else {
+                if(instance->decoder.decode_count_bit) {
+                    tpms_decoder_stats_add(TPMSDecoderStatsProtocolHyundai, TPMSDecoderStatAborts);
+                }
                 instance->decoder.parser_step = HyundaiDecoderStepReset;
             }
             break;
     }
 }
 
+const TPMSBlockGeneric* tpms_protocol_decoder_hyundai_get_generic(void* context) {
+    furi_assert(context);
+    TPMSProtocolDecoderHyundai* instance = context;
+    return &instance->generic;
+}
+
 uint8_t tpms_protocol_decoder_hyundai_get_hash_data(void* context) {
     furi_assert(context);
     TPMSProtocolDecoderHyundai* instance = context;
@@ -301,25 +312,28 @@ void tpms_protocol_decoder_hyundai_get_string(void* context, FuriString* output)
     furi_assert(context);
     TPMSProtocolDecoderHyundai* instance = context;
     
-    // Calculate pressure in kPa from stored data
-    float pressure_kpa = instance->generic.pressure * 100.0f; // Convert bar back to kPa
-    
+    // Millibar is kPa * 10, so it renders as kPa with one decimal as-is
+    char pressure_str[16];
+    tpms_format_fixed(pressure_str, sizeof(pressure_str), instance->generic.pressure_mb, 10);
+
     // Determine mode from flags
     const char* mode = "Normal";
     if(instance->generic.battery_low) {
         mode = "Battery Low";
     }
-    
+
     furi_string_printf(
         output,
         "%s\r\n"
         "Id:0x%08lX\r\n"
         "Mode:%s\r\n"
-        "Pressure:%.1f kPa\r\n"
-        "Temp:%.0f C",
+        "Pressure:%s kPa\r\n"
+        "Temp:%d C",
         instance->generic.protocol_name,
         instance->generic.id,
         mode,
-        (double)pressure_kpa,
-        (double)instance->generic.temperature);
+        pressure_str,
+        instance->generic.temperature_dc / 10);
 }
+
+#endif // TPMS_PROTOCOL_ENABLE_HYUNDAI
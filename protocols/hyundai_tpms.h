@@ -15,6 +15,7 @@ typedef struct TPMSProtocolEncoderHyundai TPMSProtocolEncoderHyundai;
 extern const SubGhzProtocolDecoder tpms_protocol_hyundai_decoder;
 extern const SubGhzProtocolEncoder tpms_protocol_hyundai_encoder;
 extern const SubGhzProtocol tpms_protocol_hyundai;
+extern const SubGhzBlockConst tpms_protocol_hyundai_const;
 
 /**
  * Allocate TPMSProtocolDecoderHyundai.
@@ -50,6 +51,13 @@ void tpms_protocol_decoder_hyundai_feed(void* context, bool level, uint32_t dura
  */
 uint8_t tpms_protocol_decoder_hyundai_get_hash_data(void* context);
 
+/**
+ * Get a direct pointer to the last decoded generic block, no serialization.
+ * @param context Pointer to a TPMSProtocolDecoderHyundai instance
+ * @return TPMSBlockGeneric* generic block
+ */
+const TPMSBlockGeneric* tpms_protocol_decoder_hyundai_get_generic(void* context);
+
 /**
  * Serialize data TPMSProtocolDecoderHyundai.
  * @param context Pointer to a TPMSProtocolDecoderHyundai instance
@@ -1,4 +1,9 @@
+#include "tpms_protocol_profile.h"
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+
 #include "nissan_tpms.h"
+#include "tpms_decoder_stats.h"
+#include "tpms_crc.h"
 #include <lib/toolbox/manchester_decoder.h>
 
 #define TAG "Nissan TPMS"
@@ -32,7 +37,7 @@
 #define NISSAN_SYNC_PATTERN 0x5A
 #define NISSAN_PREAMBLE 0xAAAAA
 
-static const SubGhzBlockConst tpms_protocol_nissan_const = {
+const SubGhzBlockConst tpms_protocol_nissan_const = {
     .te_short = 52,     // Short pulse ~52us
     .te_long = 104,     // Long pulse ~104us (2x short)
     .te_delta = 15,     // Tolerance
@@ -88,22 +93,6 @@ const SubGhzProtocol tpms_protocol_nissan = {
     .encoder = &tpms_protocol_nissan_encoder,
 };
 
-// CRC-8 with polynomial 0x07
-static uint8_t nissan_crc8(uint8_t* data, size_t len) {
-    uint8_t crc = 0x00;
-    for(size_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for(int bit = 0; bit < 8; bit++) {
-            if(crc & 0x80) {
-                crc = (crc << 1) ^ 0x07;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
-}
-
 void* tpms_protocol_decoder_nissan_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     TPMSProtocolDecoderNissan* instance = malloc(sizeof(TPMSProtocolDecoderNissan));
@@ -127,8 +116,8 @@ void tpms_protocol_decoder_nissan_reset(void* context) {
 }
 
 static bool tpms_protocol_nissan_check_crc(uint8_t* data) {
-    // CRC covers bytes 0-7, check against byte 8
-    uint8_t calc_crc = nissan_crc8(data, 8);
+    // CRC-8 poly 0x07 covers bytes 0-7, check against byte 8
+    uint8_t calc_crc = tpms_crc8_0x07(data, 8, 0x00);
     return calc_crc == data[8];
 }
 
@@ -140,14 +129,14 @@ static void tpms_protocol_nissan_analyze(TPMSBlockGeneric* instance, uint8_t* da
                    ((uint32_t)data[3] << 8) | 
                    data[4];
     
-    // Pressure calculation: 16-bit big endian, multiply by 0.25 for kPa
+    // Pressure calculation: 16-bit big endian, 0.25 kPa (2.5 millibar)
+    // per count
     uint16_t pressure_raw = ((uint16_t)data[5] << 8) | data[6];
-    float pressure_kpa = pressure_raw * 0.25f;
-    instance->pressure = pressure_kpa * 0.01f; // Convert kPa to bar
-    
+    instance->pressure_mb = (int32_t)pressure_raw * 5 / 2;
+
     // Temperature calculation: °C + 40 offset
     uint8_t temp_raw = data[7];
-    instance->temperature = temp_raw - 40.0f;
+    instance->temperature_dc = (int16_t)(((int32_t)temp_raw - 40) * 10);
     
     // Status analysis from flags
     uint8_t flags = data[8];
@@ -163,8 +152,9 @@ static void tpms_protocol_nissan_analyze(TPMSBlockGeneric* instance, uint8_t* da
     }
     instance->data_count_bit = 72;
     
-    FURI_LOG_I(TAG, "Nissan TPMS: ID=%08lX P=%.1f kPa T=%.0f°C Learn=%d Batt_Low=%d", 
-        instance->id, (double)pressure_kpa, (double)instance->temperature, learn_mode, battery_low);
+    FURI_LOG_I(TAG, "Nissan TPMS: ID=%08lX P=%ld kPa T=%d°C Learn=%d Batt_Low=%d",
+        instance->id, instance->pressure_mb / 10, instance->temperature_dc / 10,
+        learn_mode, battery_low);
 }
 
 void tpms_protocol_decoder_nissan_feed(void* context, bool level, uint32_t duration) {
@@ -206,6 +196,8 @@ void tpms_protocol_decoder_nissan_feed(void* context, bool level, uint32_t durat
                     uint8_t sync_check = instance->decoder.decode_data & 0xFF;
                     if(sync_check == NISSAN_SYNC_PATTERN) {
                         FURI_LOG_D(TAG, "Nissan sync found");
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolNissan, TPMSDecoderStatSyncs);
                         instance->decoder.parser_step = NissanDecoderStepData;
                         instance->decoder.decode_data = 0;
                         instance->decoder.decode_count_bit = 0;
@@ -235,13 +227,17 @@ void tpms_protocol_decoder_nissan_feed(void* context, bool level, uint32_t durat
                                                     tpms_protocol_nissan_const.te_delta)) {
                     bit_value = 0;
                 } else {
+                    if(instance->decoder.decode_count_bit) {
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolNissan, TPMSDecoderStatAborts);
+                    }
                     instance->decoder.parser_step = NissanDecoderStepReset;
                     break;
                 }
-                
+
                 subghz_protocol_blocks_add_bit(&instance->decoder, bit_value);
-                
-                if(instance->decoder.decode_count_bit >= 
+
+                if(instance->decoder.decode_count_bit >=
                    tpms_protocol_nissan_const.min_count_bit_for_found) {
                     
                     // Convert to byte array for processing
@@ -260,12 +256,16 @@ void tpms_protocol_decoder_nissan_feed(void* context, bool level, uint32_t durat
                     
                     if(tpms_protocol_nissan_check_crc(instance->pwm_data)) {
                         tpms_protocol_nissan_analyze(&instance->generic, instance->pwm_data);
-                        
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolNissan, TPMSDecoderStatFrames);
+
                         if(instance->base.callback) {
                             instance->base.callback(&instance->base, instance->base.context);
                         }
                     } else {
                         FURI_LOG_D(TAG, "Nissan CRC failed");
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolNissan, TPMSDecoderStatCrcErrors);
                     }
                     
                     instance->decoder.parser_step = NissanDecoderStepReset;
@@ -277,6 +277,12 @@ void tpms_protocol_decoder_nissan_feed(void* context, bool level, uint32_t durat
     }
 }
 
+const TPMSBlockGeneric* tpms_protocol_decoder_nissan_get_generic(void* context) {
+    furi_assert(context);
+    TPMSProtocolDecoderNissan* instance = context;
+    return &instance->generic;
+}
+
 uint8_t tpms_protocol_decoder_nissan_get_hash_data(void* context) {
     furi_assert(context);
     TPMSProtocolDecoderNissan* instance = context;
@@ -308,25 +314,28 @@ void tpms_protocol_decoder_nissan_get_string(void* context, FuriString* output)
     furi_assert(context);
     TPMSProtocolDecoderNissan* instance = context;
     
-    // Calculate pressure in kPa from stored data
-    float pressure_kpa = instance->generic.pressure * 100.0f; // Convert bar back to kPa
-    
+    // Millibar is kPa * 10, so it renders as kPa with one decimal as-is
+    char pressure_str[16];
+    tpms_format_fixed(pressure_str, sizeof(pressure_str), instance->generic.pressure_mb, 10);
+
     // Determine mode from flags
     const char* mode = "Normal";
     if(instance->generic.battery_low) {
         mode = "Battery Low";
     }
-    
+
     furi_string_printf(
         output,
         "%s\r\n"
         "Id:0x%08lX\r\n"
         "Mode:%s\r\n"
-        "Pressure:%.1f kPa\r\n"
-        "Temp:%.0f C",
+        "Pressure:%s kPa\r\n"
+        "Temp:%d C",
         instance->generic.protocol_name,
         instance->generic.id,
         mode,
-        (double)pressure_kpa,
-        (double)instance->generic.temperature);
+        pressure_str,
+        instance->generic.temperature_dc / 10);
 }
+
+#endif // TPMS_PROTOCOL_ENABLE_NISSAN
@@ -15,6 +15,7 @@ typedef struct TPMSProtocolEncoderNissan TPMSProtocolEncoderNissan;
 extern const SubGhzProtocolDecoder tpms_protocol_nissan_decoder;
 extern const SubGhzProtocolEncoder tpms_protocol_nissan_encoder;
 extern const SubGhzProtocol tpms_protocol_nissan;
+extern const SubGhzBlockConst tpms_protocol_nissan_const;
 
 /**
  * Allocate TPMSProtocolDecoderNissan.
@@ -50,6 +51,13 @@ void tpms_protocol_decoder_nissan_feed(void* context, bool level, uint32_t durat
  */
 uint8_t tpms_protocol_decoder_nissan_get_hash_data(void* context);
 
+/**
+ * Get a direct pointer to the last decoded generic block, no serialization.
+ * @param context Pointer to a TPMSProtocolDecoderNissan instance
+ * @return TPMSBlockGeneric* generic block
+ */
+const TPMSBlockGeneric* tpms_protocol_decoder_nissan_get_generic(void* context);
+
 /**
  * Serialize data TPMSProtocolDecoderNissan.
  * @param context Pointer to a TPMSProtocolDecoderNissan instance
@@ -1,14 +1,205 @@
 #include "protocol_items.h"
+#include "tpms_decoder_stats.h"
+
+#define TAG "TPMSProtocolItems"
 
 const SubGhzProtocol* tpms_protocol_registry_items[] = {
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
     &tpms_protocol_schrader_gg4,
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
     &tpms_protocol_toyota,
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
     &tpms_protocol_ford,
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
     &tpms_protocol_gm,
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
     &tpms_protocol_nissan,
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
     &tpms_protocol_hyundai,
+#endif
 };
 
 const SubGhzProtocolRegistry tpms_protocol_registry = {
     .items = tpms_protocol_registry_items,
     .size = COUNT_OF(tpms_protocol_registry_items)};
+
+// Timing tables of the registered decoders, same order as the registry
+static const SubGhzBlockConst* const tpms_protocol_timing_items[] = {
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+    &tpms_protocol_schrader_gg4_const,
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+    &tpms_protocol_toyota_const,
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
+    &tpms_protocol_ford_const,
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
+    &tpms_protocol_gm_const,
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+    &tpms_protocol_nissan_const,
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+    &tpms_protocol_hyundai_const,
+#endif
+};
+
+// Registry index of the current profile to the fixed stats slot
+static const TPMSDecoderStatsProtocol tpms_protocol_stats_slots[] = {
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+    TPMSDecoderStatsProtocolSchrader,
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+    TPMSDecoderStatsProtocolToyota,
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
+    TPMSDecoderStatsProtocolFord,
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
+    TPMSDecoderStatsProtocolGm,
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+    TPMSDecoderStatsProtocolNissan,
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+    TPMSDecoderStatsProtocolHyundai,
+#endif
+};
+
+TPMSDecoderStatsProtocol tpms_protocol_stats_slot(size_t registry_index) {
+    furi_assert(registry_index < COUNT_OF(tpms_protocol_stats_slots));
+    return tpms_protocol_stats_slots[registry_index];
+}
+
+// Up to three symbols per protocol: te_short, te_long and the 2*te_long
+// start/sync pulse some decoders wait for
+#define TPMS_FRONT_END_SYMBOLS_PER_PROTOCOL 3
+#define TPMS_FRONT_END_MAX_INTERVALS \
+    (COUNT_OF(tpms_protocol_timing_items) * TPMS_FRONT_END_SYMBOLS_PER_PROTOCOL)
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+    uint8_t protocol_mask;
+} TPMSPulseInterval;
+
+static TPMSPulseInterval tpms_front_end_intervals[TPMS_FRONT_END_MAX_INTERVALS];
+static size_t tpms_front_end_interval_count;
+static uint8_t tpms_front_end_reject_run;
+
+static void tpms_protocol_front_end_add_interval(uint32_t te, uint32_t delta, uint8_t mask) {
+    uint32_t min = (te > delta) ? (te - delta) : 1;
+    uint32_t max = te + delta;
+
+    // Keep the list sorted by min and merge overlapping windows
+    size_t pos = 0;
+    while(pos < tpms_front_end_interval_count && tpms_front_end_intervals[pos].min < min) {
+        pos++;
+    }
+    for(size_t i = tpms_front_end_interval_count; i > pos; i--) {
+        tpms_front_end_intervals[i] = tpms_front_end_intervals[i - 1];
+    }
+    tpms_front_end_intervals[pos] =
+        (TPMSPulseInterval){.min = min, .max = max, .protocol_mask = mask};
+    tpms_front_end_interval_count++;
+
+    size_t i = 0;
+    while(i + 1 < tpms_front_end_interval_count) {
+        TPMSPulseInterval* a = &tpms_front_end_intervals[i];
+        TPMSPulseInterval* b = &tpms_front_end_intervals[i + 1];
+        if(b->min <= a->max) {
+            a->max = MAX(a->max, b->max);
+            a->protocol_mask |= b->protocol_mask;
+            for(size_t j = i + 1; j + 1 < tpms_front_end_interval_count; j++) {
+                tpms_front_end_intervals[j] = tpms_front_end_intervals[j + 1];
+            }
+            tpms_front_end_interval_count--;
+        } else {
+            i++;
+        }
+    }
+}
+
+void tpms_protocol_front_end_init(void) {
+    tpms_front_end_interval_count = 0;
+    tpms_front_end_reject_run = 0;
+    for(size_t i = 0; i < COUNT_OF(tpms_protocol_timing_items); i++) {
+        const SubGhzBlockConst* timing = tpms_protocol_timing_items[i];
+        uint8_t mask = 1 << i;
+        tpms_protocol_front_end_add_interval(timing->te_short, timing->te_delta, mask);
+        tpms_protocol_front_end_add_interval(timing->te_long, timing->te_delta, mask);
+        tpms_protocol_front_end_add_interval(timing->te_long * 2, timing->te_delta, mask);
+    }
+    FURI_LOG_D(TAG, "front end: %zu pulse classes", tpms_front_end_interval_count);
+}
+
+uint8_t tpms_protocol_front_end_classify(uint32_t duration) {
+    for(size_t i = 0; i < tpms_front_end_interval_count; i++) {
+        if(duration < tpms_front_end_intervals[i].min) break;
+        if(duration <= tpms_front_end_intervals[i].max) {
+            return tpms_front_end_intervals[i].protocol_mask;
+        }
+    }
+    return 0;
+}
+
+void tpms_protocol_front_end_feed(void* context, bool level, uint32_t duration) {
+    SubGhzReceiver* receiver = context;
+
+    uint8_t mask = tpms_protocol_front_end_classify(duration);
+    if(mask) {
+        for(size_t i = 0; mask; i++, mask >>= 1) {
+            if(mask & 1) tpms_decoder_stats_add(tpms_protocol_stats_slot(i), TPMSDecoderStatEdges);
+        }
+        tpms_front_end_reject_run = 0;
+        subghz_receiver_decode(receiver, level, duration);
+    } else {
+        // Deliver the first out-of-alphabet edge of a run so the decoder
+        // state machines see their reset event, swallow the rest
+        if(tpms_front_end_reject_run == 0) {
+            subghz_receiver_decode(receiver, level, duration);
+        }
+        if(tpms_front_end_reject_run < UINT8_MAX) tpms_front_end_reject_run++;
+    }
+}
+
+const TPMSBlockGeneric* tpms_protocol_get_generic(SubGhzProtocolDecoderBase* decoder_base) {
+    furi_assert(decoder_base);
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+    if(decoder_base->protocol == &tpms_protocol_schrader_gg4) {
+        return tpms_protocol_decoder_schrader_gg4_get_generic(decoder_base);
+    }
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+    if(decoder_base->protocol == &tpms_protocol_toyota) {
+        return tpms_protocol_decoder_toyota_get_generic(decoder_base);
+    }
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
+    if(decoder_base->protocol == &tpms_protocol_ford) {
+        return tpms_protocol_decoder_ford_get_generic(decoder_base);
+    }
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
+    if(decoder_base->protocol == &tpms_protocol_gm) {
+        return tpms_protocol_decoder_gm_get_generic(decoder_base);
+    }
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+    if(decoder_base->protocol == &tpms_protocol_nissan) {
+        return tpms_protocol_decoder_nissan_get_generic(decoder_base);
+    }
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+    if(decoder_base->protocol == &tpms_protocol_hyundai) {
+        return tpms_protocol_decoder_hyundai_get_generic(decoder_base);
+    }
+#endif
+    return NULL;
+}
@@ -1,11 +1,64 @@
 #pragma once
 #include "../tpms_app_i.h"
 
+#include "tpms_protocol_profile.h"
+#include "tpms_decoder_stats.h"
+
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
 #include "schrader_gg4.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
 #include "toyota_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
 #include "ford_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
 #include "gm_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
 #include "nissan_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
 #include "hyundai_tpms.h"
+#endif
 
 extern const SubGhzProtocolRegistry tpms_protocol_registry;
+
+/**
+ * Translate a registry index of the current build profile to its fixed
+ * decoder-stats slot.
+ * @param registry_index index into tpms_protocol_registry
+ * @return decoder-stats slot of that protocol
+ */
+TPMSDecoderStatsProtocol tpms_protocol_stats_slot(size_t registry_index);
+
+/**
+ * Build the shared pulse-classification tables from the registered
+ * protocols' timing constants. Call once before feeding edges.
+ */
+void tpms_protocol_front_end_init(void);
+
+/**
+ * Classify one duration against the merged timing alphabet.
+ * @param duration Duration, us
+ * @return bitmask of registry slots whose timing tables match, 0 for noise
+ */
+uint8_t tpms_protocol_front_end_classify(uint32_t duration);
+
+/**
+ * SubGhzWorker pair callback: classify each edge once and fan out to the
+ * receiver only when at least one decoder's timing alphabet matches.
+ * @param context Pointer to a SubGhzReceiver instance
+ * @param level Signal level
+ * @param duration Duration of this level, us
+ */
+void tpms_protocol_front_end_feed(void* context, bool level, uint32_t duration);
+
+/**
+ * Get the decoded generic block of any registered decoder as plain struct
+ * fields, bypassing FlipperFormat serialization.
+ * @param decoder_base Pointer to a SubGhzProtocolDecoderBase instance
+ * @return TPMSBlockGeneric* generic block, NULL for unknown protocols
+ */
+const TPMSBlockGeneric* tpms_protocol_get_generic(SubGhzProtocolDecoderBase* decoder_base);
@@ -1,5 +1,12 @@
+#include "tpms_protocol_profile.h"
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+
 #include "schrader_gg4.h"
-#include <lib/toolbox/manchester_decoder.h>
+#include "tpms_decoder_stats.h"
+#include "tpms_burst_combine.h"
+#include "tpms_timing_cal.h"
+#include "tpms_crc.h"
+#include "tpms_manchester.h"
 
 #define TAG "Schrader"
 
@@ -43,7 +50,7 @@ Data layout:
 #define PREAMBLE 0b000
 #define PREAMBLE_BITS_LEN 3
 
-static const SubGhzBlockConst tpms_protocol_schrader_gg4_const = {
+const SubGhzBlockConst tpms_protocol_schrader_gg4_const = {
     .te_short = 120,
     .te_long = 240,
     .te_delta = 55, // 50% of te_short due to poor sensitivity
@@ -136,7 +143,7 @@ static bool tpms_protocol_schrader_gg4_check_crc(TPMSProtocolDecoderSchraderGG4*
         instance->decoder.decode_data >> 16,
         instance->decoder.decode_data >> 8};
 
-    uint8_t crc = subghz_protocol_blocks_crc8(msg, 6, 0x7, 0);
+    uint8_t crc = tpms_crc8_0x07(msg, 6, 0x00);
     return (crc == (instance->decoder.decode_data & 0xFF));
 }
 
@@ -147,23 +154,37 @@ static bool tpms_protocol_schrader_gg4_check_crc(TPMSProtocolDecoderSchraderGG4*
 static void tpms_protocol_schrader_gg4_analyze(TPMSBlockGeneric* instance) {
     instance->id = instance->data >> 24;
 
+    // Status byte is 0x30 while the sensor answers a relearn trigger
+    instance->in_relearn = ((instance->data >> 56) & 0xFF) == 0x30;
+
     // TODO locate and fix
     instance->battery_low = TPMS_NO_BATT;
 
-    instance->temperature = ((instance->data >> 8) & 0xFF) - 50;
-    instance->pressure = ((instance->data >> 16) & 0xFF) * 2.5 * 0.069;
+    instance->temperature_dc = (int16_t)((((instance->data >> 8) & 0xFF) - 50) * 10);
+    // Raw step is 2.5 * 0.069 bar, i.e. 345 millibar per two counts
+    instance->pressure_mb = (int32_t)((instance->data >> 16) & 0xFF) * 345 / 2;
 }
 
 static ManchesterEvent level_and_duration_to_event(bool level, uint32_t duration) {
     bool is_long = false;
 
+    // Shift by the learned site offset, then feed the residual back so
+    // the calibration tracks slow drift
+    duration = tpms_timing_cal_apply(TPMSDecoderStatsProtocolSchrader, duration);
+
     if(DURATION_DIFF(duration, tpms_protocol_schrader_gg4_const.te_long) <
        tpms_protocol_schrader_gg4_const.te_delta) {
         is_long = true;
+        tpms_timing_cal_note(
+            TPMSDecoderStatsProtocolSchrader,
+            (int32_t)duration - (int32_t)tpms_protocol_schrader_gg4_const.te_long);
     } else if(
         DURATION_DIFF(duration, tpms_protocol_schrader_gg4_const.te_short) <
         tpms_protocol_schrader_gg4_const.te_delta) {
         is_long = false;
+        tpms_timing_cal_note(
+            TPMSDecoderStatsProtocolSchrader,
+            (int32_t)duration - (int32_t)tpms_protocol_schrader_gg4_const.te_short);
     } else {
         return ManchesterEventReset;
     }
@@ -193,12 +214,13 @@ void tpms_protocol_decoder_schrader_gg4_feed(void* context, bool level, uint32_t
                     "reset accumulated %d bits: %llx",
                     instance->decoder.decode_count_bit,
                     instance->decoder.decode_data);
+                tpms_decoder_stats_add(TPMSDecoderStatsProtocolSchrader, TPMSDecoderStatAborts);
             }
+            tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocolSchrader);
 
             instance->decoder.parser_step = SchraderGG4DecoderStepReset;
         } else {
-            have_bit = manchester_advance(
-                instance->manchester_saved_state, event, &instance->manchester_saved_state, &bit);
+            have_bit = tpms_manchester_advance(&instance->manchester_saved_state, event, &bit);
             if(!have_bit) return;
 
             // Invert value, due to signal is Manchester II and decoder is Manchester I
@@ -215,6 +237,8 @@ void tpms_protocol_decoder_schrader_gg4_feed(void* context, bool level, uint32_t
             instance->header_count = 0;
             instance->decoder.decode_data = 0;
             instance->decoder.decode_count_bit = 0;
+            // Symbols of an attempt that fizzled out must not carry over
+            tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocolSchrader);
 
             // First will be short space, so set correct initial state for machine
             // https://clearwater.com.au/images/rc5/rc5-state-machine.gif
@@ -228,8 +252,10 @@ void tpms_protocol_decoder_schrader_gg4_feed(void* context, bool level, uint32_t
         }
 
         instance->header_count++;
-        if(instance->header_count == PREAMBLE_BITS_LEN)
+        if(instance->header_count == PREAMBLE_BITS_LEN) {
+            tpms_decoder_stats_add(TPMSDecoderStatsProtocolSchrader, TPMSDecoderStatSyncs);
             instance->decoder.parser_step = SchraderGG4DecoderStepDecoderData;
+        }
         break;
 
     case SchraderGG4DecoderStepDecoderData:
@@ -239,10 +265,33 @@ void tpms_protocol_decoder_schrader_gg4_feed(void* context, bool level, uint32_t
             FURI_LOG_D(TAG, "%016llx", instance->decoder.decode_data);
             if(!tpms_protocol_schrader_gg4_check_crc(instance)) {
                 FURI_LOG_D(TAG, "CRC mismatch drop");
+                tpms_decoder_stats_add(TPMSDecoderStatsProtocolSchrader, TPMSDecoderStatCrcErrors);
+                tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocolSchrader);
+                // Each repetition of a weak burst tends to corrupt a
+                // different bit, a majority vote may still recover it
+                uint64_t voted;
+                if(tpms_burst_combine_push(
+                       TPMSDecoderStatsProtocolSchrader, instance->decoder.decode_data, &voted)) {
+                    instance->decoder.decode_data = voted;
+                    if(tpms_protocol_schrader_gg4_check_crc(instance)) {
+                        FURI_LOG_I(TAG, "frame recovered by majority vote");
+                        instance->generic.data = voted;
+                        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
+                        tpms_protocol_schrader_gg4_analyze(&instance->generic);
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolSchrader, TPMSDecoderStatFrames);
+                        tpms_burst_combine_clear(TPMSDecoderStatsProtocolSchrader);
+                        if(instance->base.callback)
+                            instance->base.callback(&instance->base, instance->base.context);
+                    }
+                }
             } else {
                 instance->generic.data = instance->decoder.decode_data;
                 instance->generic.data_count_bit = instance->decoder.decode_count_bit;
                 tpms_protocol_schrader_gg4_analyze(&instance->generic);
+                tpms_decoder_stats_add(TPMSDecoderStatsProtocolSchrader, TPMSDecoderStatFrames);
+                tpms_burst_combine_clear(TPMSDecoderStatsProtocolSchrader);
+                tpms_timing_cal_frame_good(TPMSDecoderStatsProtocolSchrader);
                 if(instance->base.callback)
                     instance->base.callback(&instance->base, instance->base.context);
             }
@@ -252,6 +301,12 @@ void tpms_protocol_decoder_schrader_gg4_feed(void* context, bool level, uint32_t
     }
 }
 
+const TPMSBlockGeneric* tpms_protocol_decoder_schrader_gg4_get_generic(void* context) {
+    furi_assert(context);
+    TPMSProtocolDecoderSchraderGG4* instance = context;
+    return &instance->generic;
+}
+
 uint8_t tpms_protocol_decoder_schrader_gg4_get_hash_data(void* context) {
     furi_assert(context);
     TPMSProtocolDecoderSchraderGG4* instance = context;
@@ -281,15 +336,20 @@ SubGhzProtocolStatus
 void tpms_protocol_decoder_schrader_gg4_get_string(void* context, FuriString* output) {
     furi_assert(context);
     TPMSProtocolDecoderSchraderGG4* instance = context;
+    char pressure_str[16];
+    tpms_format_fixed(
+        pressure_str, sizeof(pressure_str), (instance->generic.pressure_mb + 50) / 100, 10);
     furi_string_printf(
         output,
         "%s\r\n"
         "Id:0x%08lX\r\n"
         "Bat:%d\r\n"
-        "Temp:%2.0f C Bar:%2.1f",
+        "Temp:%d C Bar:%s",
         instance->generic.protocol_name,
         instance->generic.id,
         instance->generic.battery_low,
-        (double)instance->generic.temperature,
-        (double)instance->generic.pressure);
+        instance->generic.temperature_dc / 10,
+        pressure_str);
 }
+
+#endif // TPMS_PROTOCOL_ENABLE_SCHRADER
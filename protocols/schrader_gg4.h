@@ -16,6 +16,7 @@ typedef struct TPMSProtocolEncoderSchraderGG4 TPMSProtocolEncoderSchraderGG4;
 extern const SubGhzProtocolDecoder tpms_protocol_schrader_gg4_decoder;
 extern const SubGhzProtocolEncoder tpms_protocol_schrader_gg4_encoder;
 extern const SubGhzProtocol tpms_protocol_schrader_gg4;
+extern const SubGhzBlockConst tpms_protocol_schrader_gg4_const;
 
 /**
  * Allocate TPMSProtocolDecoderSchraderGG4.
@@ -51,6 +52,13 @@ void tpms_protocol_decoder_schrader_gg4_feed(void* context, bool level, uint32_t
  */
 uint8_t tpms_protocol_decoder_schrader_gg4_get_hash_data(void* context);
 
+/**
+ * Get a direct pointer to the last decoded generic block, no serialization.
+ * @param context Pointer to a TPMSProtocolDecoderSchraderGG4 instance
+ * @return TPMSBlockGeneric* generic block
+ */
+const TPMSBlockGeneric* tpms_protocol_decoder_schrader_gg4_get_generic(void* context);
+
 /**
  * Serialize data TPMSProtocolDecoderSchraderGG4.
  * @param context Pointer to a TPMSProtocolDecoderSchraderGG4 instance
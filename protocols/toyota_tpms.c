@@ -1,4 +1,9 @@
+#include "tpms_protocol_profile.h"
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+
 #include "toyota_tpms.h"
+#include "tpms_decoder_stats.h"
+#include "tpms_crc.h"
 #include <lib/toolbox/manchester_decoder.h>
 
 #define TAG "Toyota TPMS"
@@ -24,10 +29,9 @@
  * Pressure: 1/4 PSI offset by -7 PSI (28 raw = 0 PSI)
  */
 
-// Sync pattern: 0xa9, 0xe0 (12 bits)
-static const uint8_t toyota_sync_pattern[] = {0xa9, 0xe0};
+// Sync pattern: 0xa9, 0xe0 (12 bits), matched inline in the feed below
 
-static const SubGhzBlockConst tpms_protocol_toyota_const = {
+const SubGhzBlockConst tpms_protocol_toyota_const = {
     .te_short = 52,     // FSK bit period ~52us for ~19.2kbps
     .te_long = 52,      // Same for FSK
     .te_delta = 15,     // Tolerance
@@ -109,7 +113,7 @@ void tpms_protocol_decoder_toyota_reset(void* context) {
 
 static bool tpms_protocol_toyota_check_crc(uint8_t* data) {
     // CRC-8 with poly 0x07, init 0x80
-    uint8_t crc = subghz_protocol_blocks_crc8(data, 8, 0x07, 0x80);
+    uint8_t crc = tpms_crc8_0x07(data, 8, 0x80);
     return (crc == data[8]);
 }
 
@@ -131,9 +135,10 @@ static void tpms_protocol_toyota_analyze(TPMSBlockGeneric* instance, uint8_t* da
         return;
     }
     
-    // Convert to physical units
-    instance->temperature = temp - 40.0f;  // Offset by 40°C
-    instance->pressure = (pressure1 * 0.25f - 7.0f) * 0.0689476f;  // Convert PSI to bar
+    // Convert to physical units: temperature offset by 40°C, pressure is
+    // (raw * 0.25 - 7) PSI at 68.948 millibar per PSI
+    instance->temperature_dc = (int16_t)(((int32_t)temp - 40) * 10);
+    instance->pressure_mb = ((int32_t)pressure1 * 172369 - 4826332) / 10000;
     instance->battery_low = (status & 0x80) ? 1 : 0;  // Status bit indicates battery
     
     // Store raw data
@@ -176,6 +181,8 @@ void tpms_protocol_decoder_toyota_feed(void* context, bool level, uint32_t durat
                                          (instance->decoder.decode_count_bit - 12)) & 0xFFF;
                     if(sync_check == 0xa9e) {
                         FURI_LOG_D(TAG, "Toyota sync found");
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolToyota, TPMSDecoderStatSyncs);
                         instance->decoder.parser_step = ToyotaDecoderStepData;
                         instance->decoder.decode_data = 0;
                         instance->decoder.decode_count_bit = 0;
@@ -206,9 +213,13 @@ void tpms_protocol_decoder_toyota_feed(void* context, bool level, uint32_t durat
                 if(instance->decoder.decode_count_bit >= 
                    tpms_protocol_toyota_const.min_count_bit_for_found) {
                     
-                    // Convert to byte array for processing
-                    for(int i = 0; i < 9; i++) {
-                        instance->manchester_data[i] = 
+                    // Convert to byte array for processing. Bits past the
+                    // 64-bit accumulator are lost, so the leading byte is
+                    // always zero by construction; writing it out avoids
+                    // an undefined shift by 64
+                    instance->manchester_data[0] = 0;
+                    for(int i = 1; i < 9; i++) {
+                        instance->manchester_data[i] =
                             (instance->decoder.decode_data >> ((8-i) * 8)) & 0xFF;
                     }
                     
@@ -221,23 +232,37 @@ void tpms_protocol_decoder_toyota_feed(void* context, bool level, uint32_t durat
                     
                     if(tpms_protocol_toyota_check_crc(instance->manchester_data)) {
                         tpms_protocol_toyota_analyze(&instance->generic, instance->manchester_data);
-                        
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolToyota, TPMSDecoderStatFrames);
+
                         if(instance->base.callback) {
                             instance->base.callback(&instance->base, instance->base.context);
                         }
                     } else {
                         FURI_LOG_D(TAG, "Toyota CRC check failed");
+                        tpms_decoder_stats_add(
+                            TPMSDecoderStatsProtocolToyota, TPMSDecoderStatCrcErrors);
                     }
                     
                     instance->decoder.parser_step = ToyotaDecoderStepReset;
                 }
             } else {
+                if(instance->decoder.decode_count_bit) {
+                    tpms_decoder_stats_add(
+                        TPMSDecoderStatsProtocolToyota, TPMSDecoderStatAborts);
+                }
                 instance->decoder.parser_step = ToyotaDecoderStepReset;
             }
             break;
     }
 }
 
+const TPMSBlockGeneric* tpms_protocol_decoder_toyota_get_generic(void* context) {
+    furi_assert(context);
+    TPMSProtocolDecoderToyota* instance = context;
+    return &instance->generic;
+}
+
 uint8_t tpms_protocol_decoder_toyota_get_hash_data(void* context) {
     furi_assert(context);
     TPMSProtocolDecoderToyota* instance = context;
@@ -268,16 +293,23 @@ SubGhzProtocolStatus tpms_protocol_decoder_toyota_deserialize(
 void tpms_protocol_decoder_toyota_get_string(void* context, FuriString* output) {
     furi_assert(context);
     TPMSProtocolDecoderToyota* instance = context;
+    char temp_str[16];
+    char pressure_str[16];
+    tpms_format_fixed(temp_str, sizeof(temp_str), instance->generic.temperature_dc, 10);
+    tpms_format_fixed(
+        pressure_str, sizeof(pressure_str), (instance->generic.pressure_mb + 5) / 10, 100);
     furi_string_printf(
         output,
         "%s\r\n"
         "Id:0x%08lX\r\n"
         "Bat:%s\r\n"
-        "Temp:%.1f C Bar:%.2f",
+        "Temp:%s C Bar:%s",
         instance->generic.protocol_name,
         instance->generic.id,
-        instance->generic.battery_low == TPMS_NO_BATT ? "?" : 
+        instance->generic.battery_low == TPMS_NO_BATT ? "?" :
             (instance->generic.battery_low ? "LOW" : "OK"),
-        (double)instance->generic.temperature,
-        (double)instance->generic.pressure);
+        temp_str,
+        pressure_str);
 }
+
+#endif // TPMS_PROTOCOL_ENABLE_TOYOTA
@@ -15,6 +15,7 @@ typedef struct TPMSProtocolEncoderToyota TPMSProtocolEncoderToyota;
 extern const SubGhzProtocolDecoder tpms_protocol_toyota_decoder;
 extern const SubGhzProtocolEncoder tpms_protocol_toyota_encoder;
 extern const SubGhzProtocol tpms_protocol_toyota;
+extern const SubGhzBlockConst tpms_protocol_toyota_const;
 
 /**
  * Allocate TPMSProtocolDecoderToyota.
@@ -50,6 +51,13 @@ void tpms_protocol_decoder_toyota_feed(void* context, bool level, uint32_t durat
  */
 uint8_t tpms_protocol_decoder_toyota_get_hash_data(void* context);
 
+/**
+ * Get a direct pointer to the last decoded generic block, no serialization.
+ * @param context Pointer to a TPMSProtocolDecoderToyota instance
+ * @return TPMSBlockGeneric* generic block
+ */
+const TPMSBlockGeneric* tpms_protocol_decoder_toyota_get_generic(void* context);
+
 /**
  * Serialize data TPMSProtocolDecoderToyota.
  * @param context Pointer to a TPMSProtocolDecoderToyota instance
@@ -0,0 +1,348 @@
+#include "tpms_benchmark_streams.h"
+#include "tpms_protocol_profile.h"
+#include "tpms_decoder_stats.h"
+#include <lib/toolbox/manchester_decoder.h>
+
+// Only the timing constants are needed here; pulling the individual
+// decoder headers instead of protocol_items.h keeps this translation
+// unit buildable off-device for the host benchmark
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+#include "schrader_gg4.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+#include "toyota_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
+#include "ford_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
+#include "gm_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+#include "nissan_tpms.h"
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+#include "hyundai_tpms.h"
+#endif
+
+#define TAG "TPMSBenchmarkStreams"
+
+// Gap long enough to fall outside every timing alphabet, forces the
+// decoders back to their reset step between replays
+#define TPMS_BENCHMARK_GAP_US 30000
+
+typedef struct {
+    uint32_t* edges;
+    size_t count;
+    size_t cap;
+    bool overflow;
+} TPMSBenchmarkBuilder;
+
+static void bench_push(TPMSBenchmarkBuilder* builder, bool level, uint32_t duration) {
+    if(builder->count >= builder->cap) {
+        builder->overflow = true;
+        return;
+    }
+    builder->edges[builder->count++] =
+        (duration & ~TPMS_BENCHMARK_EDGE_LEVEL_BIT) | (level ? TPMS_BENCHMARK_EDGE_LEVEL_BIT : 0);
+}
+
+static uint8_t bench_crc8(const uint8_t* data, size_t len, uint8_t poly, uint8_t init) {
+    uint8_t crc = init;
+    for(size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for(int bit = 0; bit < 8; bit++) {
+            if(crc & 0x80) {
+                crc = (crc << 1) ^ poly;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+/** Raw-level phases: one edge per bit, the decoder samples the level */
+static void bench_push_level_bits(
+    TPMSBenchmarkBuilder* builder,
+    uint64_t data,
+    uint8_t bit_count,
+    uint32_t te) {
+    for(int i = bit_count - 1; i >= 0; i--) {
+        bench_push(builder, (data >> i) & 1, te);
+    }
+}
+
+/** Nissan-style PWM: bit in the high duration, short low as the strobe */
+static void bench_push_pwm_bits(
+    TPMSBenchmarkBuilder* builder,
+    uint64_t data,
+    uint8_t bit_count,
+    uint32_t te_short,
+    uint32_t te_long) {
+    for(int i = bit_count - 1; i >= 0; i--) {
+        bench_push(builder, true, ((data >> i) & 1) ? te_long : te_short);
+        bench_push(builder, false, te_short);
+    }
+}
+
+typedef struct {
+    ManchesterEvent event;
+    bool level;
+    bool is_long;
+} TPMSBenchmarkSymbol;
+
+static const TPMSBenchmarkSymbol bench_symbols_short[] = {
+    {ManchesterEventShortLow, false, false},
+    {ManchesterEventShortHigh, true, false},
+};
+
+static const TPMSBenchmarkSymbol bench_symbols_all[] = {
+    {ManchesterEventShortLow, false, false},
+    {ManchesterEventShortHigh, true, false},
+    {ManchesterEventLongLow, false, true},
+    {ManchesterEventLongHigh, true, true},
+};
+
+/**
+ * Find an event sequence that makes manchester_advance emit exactly one
+ * target bit from the given state. Searching against the very decoder the
+ * stream is replayed into guarantees the stream stays decodable even if
+ * the state machine changes underneath us.
+ */
+static bool bench_search_bit(
+    ManchesterState state,
+    bool target,
+    const TPMSBenchmarkSymbol* symbols,
+    size_t symbol_count,
+    TPMSBenchmarkSymbol* path,
+    size_t* path_count,
+    size_t max_depth,
+    ManchesterState* final_state) {
+    if(max_depth == 0) return false;
+    for(size_t i = 0; i < symbol_count; i++) {
+        ManchesterState next = state;
+        bool data = false;
+        if(manchester_advance(state, symbols[i].event, &next, &data)) {
+            if(data != target) continue;
+            path[0] = symbols[i];
+            *path_count = 1;
+            *final_state = next;
+            return true;
+        }
+        size_t sub_count = 0;
+        if(bench_search_bit(
+               next, target, symbols, symbol_count, path + 1, &sub_count, max_depth - 1,
+               final_state)) {
+            path[0] = symbols[i];
+            *path_count = sub_count + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool bench_push_manchester_bits(
+    TPMSBenchmarkBuilder* builder,
+    ManchesterState* state,
+    uint64_t data,
+    uint8_t bit_count,
+    bool invert,
+    bool allow_long,
+    uint32_t te_short,
+    uint32_t te_long) {
+    const TPMSBenchmarkSymbol* symbols = allow_long ? bench_symbols_all : bench_symbols_short;
+    size_t symbol_count = allow_long ? COUNT_OF(bench_symbols_all) : COUNT_OF(bench_symbols_short);
+
+    for(int i = bit_count - 1; i >= 0; i--) {
+        bool target = (data >> i) & 1;
+        if(invert) target = !target;
+        TPMSBenchmarkSymbol path[3];
+        size_t path_count = 0;
+        if(!bench_search_bit(
+               *state, target, symbols, symbol_count, path, &path_count, COUNT_OF(path), state)) {
+            return false;
+        }
+        for(size_t j = 0; j < path_count; j++) {
+            bench_push(builder, path[j].level, path[j].is_long ? te_long : te_short);
+        }
+    }
+    return true;
+}
+
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+/** Schrader GG4: 480us start pulse, 3 zero preamble bits and 64 Manchester
+ *  bits; the decoder inverts Manchester II into I, so targets are inverted */
+static bool bench_build_schrader(TPMSBenchmarkBuilder* builder) {
+    const SubGhzBlockConst* t = &tpms_protocol_schrader_gg4_const;
+    uint8_t msg[6] = {0x3A, 0xBC, 0xDE, 0x7D, 0x5A, 0x32};
+    uint8_t crc = bench_crc8(msg, sizeof(msg), 0x07, 0x00);
+    uint64_t data = 0x80;
+    for(size_t i = 0; i < sizeof(msg); i++) data = (data << 8) | msg[i];
+    data = (data << 8) | crc;
+
+    bench_push(builder, true, t->te_long * 2);
+    ManchesterState state = ManchesterStateStart1;
+    if(!bench_push_manchester_bits(builder, &state, 0, 3, true, true, t->te_short, t->te_long)) {
+        return false;
+    }
+    return bench_push_manchester_bits(
+        builder, &state, data, 64, true, true, t->te_short, t->te_long);
+}
+#endif
+
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+/** Toyota: 12 raw sync bits 0xa9e then 72 raw data bits. The decoder reads
+ *  its first payload byte from bits shifted past the 64-bit accumulator,
+ *  which evaluates as zero on the target, so the checksum covers a zero
+ *  leading byte */
+static bool bench_build_toyota(TPMSBenchmarkBuilder* builder) {
+    const SubGhzBlockConst* t = &tpms_protocol_toyota_const;
+    // Byte 7 carries the inverted pressure, the analyzer rejects the
+    // frame unless it matches bytes 4/5
+    uint8_t msg[9] = {0x00, 0x4A, 0x3B, 0x9C, 0x2A, 0x3C, 0x64, 0xAB, 0x00};
+    msg[8] = bench_crc8(msg, 8, 0x07, 0x80);
+
+    bench_push(builder, true, t->te_short);
+    bench_push_level_bits(builder, 0xa9e, 12, t->te_short);
+    for(size_t i = 0; i < sizeof(msg); i++) {
+        bench_push_level_bits(builder, msg[i], 8, t->te_short);
+    }
+    return true;
+}
+#endif
+
+#if TPMS_PROTOCOL_ENABLE_FORD
+/** Ford: 16 raw sync bits 0xaaa9 then 64 Manchester bits with a sum
+ *  checksum in the last byte */
+static bool bench_build_ford(TPMSBenchmarkBuilder* builder) {
+    const SubGhzBlockConst* t = &tpms_protocol_ford_const;
+    uint8_t msg[8] = {0x15, 0x27, 0x4E, 0x91, 0x62, 0x33, 0x08, 0x00};
+    uint8_t sum = 0;
+    for(size_t i = 0; i < 7; i++) sum += msg[i];
+    msg[7] = sum;
+    uint64_t data = 0;
+    for(size_t i = 0; i < sizeof(msg); i++) data = (data << 8) | msg[i];
+
+    bench_push(builder, true, t->te_short);
+    bench_push_level_bits(builder, 0xaaa9, 16, t->te_short);
+    ManchesterState state = ManchesterStateStart1;
+    return bench_push_manchester_bits(
+        builder, &state, data, 64, false, true, t->te_short, 2 * t->te_short);
+}
+#endif
+
+#if TPMS_PROTOCOL_ENABLE_GM
+/** GM: 16 raw preamble+sync bits 0x555D, then 72 Manchester bits of which
+ *  the decoder keeps the last 56 as payload; CRC-8/0x31 spans the sync
+ *  bytes it re-prepends */
+static bool bench_build_gm(TPMSBenchmarkBuilder* builder) {
+    const SubGhzBlockConst* t = &tpms_protocol_gm_const;
+    uint8_t packet[9] = {0x55, 0x5D, 0x6B, 0x21, 0x9D, 0x44, 0x57, 0x3C, 0x00};
+    packet[8] = bench_crc8(packet, 8, 0x31, 0x00);
+    uint64_t payload = 0;
+    for(size_t i = 2; i < sizeof(packet); i++) payload = (payload << 8) | packet[i];
+
+    bench_push(builder, true, t->te_short);
+    bench_push_level_bits(builder, 0x555D, 16, t->te_short);
+    ManchesterState state = ManchesterStateStart1;
+    // 16 padding bits shift out of the accumulator before the frame check
+    if(!bench_push_manchester_bits(
+           builder, &state, 0, 16, false, true, t->te_short, 2 * t->te_short)) {
+        return false;
+    }
+    return bench_push_manchester_bits(
+        builder, &state, payload, 56, false, true, t->te_short, 2 * t->te_short);
+}
+#endif
+
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+/** Nissan: PWM with a 20-bit alternating preamble, 0x5A sync and 64 data
+ *  bits; CRC-8/0x07 spans the sync byte the decoder re-prepends */
+static bool bench_build_nissan(TPMSBenchmarkBuilder* builder) {
+    const SubGhzBlockConst* t = &tpms_protocol_nissan_const;
+    uint8_t packet[9] = {0x5A, 0x2F, 0x84, 0x1B, 0xC6, 0x58, 0x3D, 0x72, 0x00};
+    packet[8] = bench_crc8(packet, 8, 0x07, 0x00);
+    uint64_t payload = 0;
+    for(size_t i = 1; i < sizeof(packet); i++) payload = (payload << 8) | packet[i];
+
+    bench_push(builder, true, t->te_long);
+    bench_push_pwm_bits(builder, ((uint64_t)0xAAAAA << 8) | 0x5A, 28, t->te_short, t->te_long);
+    // 8 padding bits shift out of the accumulator before the frame check
+    bench_push_pwm_bits(builder, 0, 8, t->te_short, t->te_long);
+    bench_push_pwm_bits(builder, payload, 64, t->te_short, t->te_long);
+    return true;
+}
+#endif
+
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+/** Hyundai: 28 raw preamble+sync bits 0x5555556, then 80 Manchester bits
+ *  of which the decoder keeps the last 56 as payload; CRC-8/0x31 spans the
+ *  three sync bytes it re-prepends */
+static bool bench_build_hyundai(TPMSBenchmarkBuilder* builder) {
+    const SubGhzBlockConst* t = &tpms_protocol_hyundai_const;
+    uint8_t packet[10] = {0x55, 0x55, 0x56, 0x19, 0xA7, 0x33, 0xD2, 0x4B, 0x66, 0x00};
+    packet[9] = bench_crc8(packet, 9, 0x31, 0x00);
+    uint64_t payload = 0;
+    for(size_t i = 3; i < sizeof(packet); i++) payload = (payload << 8) | packet[i];
+
+    bench_push(builder, true, t->te_short);
+    bench_push_level_bits(builder, 0x5555556, 28, t->te_short);
+    ManchesterState state = ManchesterStateStart1;
+    // 24 padding bits shift out of the accumulator before the frame check
+    if(!bench_push_manchester_bits(
+           builder, &state, 0, 24, false, true, t->te_short, 2 * t->te_short)) {
+        return false;
+    }
+    return bench_push_manchester_bits(
+        builder, &state, payload, 56, false, true, t->te_short, 2 * t->te_short);
+}
+#endif
+
+size_t tpms_benchmark_stream_build(size_t protocol_index, uint32_t* edges, size_t max_edges) {
+    furi_assert(edges);
+    TPMSBenchmarkBuilder builder = {.edges = edges, .count = 0, .cap = max_edges};
+    bool ok = false;
+
+    switch(protocol_index) {
+#if TPMS_PROTOCOL_ENABLE_SCHRADER
+    case TPMSDecoderStatsProtocolSchrader:
+        ok = bench_build_schrader(&builder);
+        break;
+#endif
+#if TPMS_PROTOCOL_ENABLE_TOYOTA
+    case TPMSDecoderStatsProtocolToyota:
+        ok = bench_build_toyota(&builder);
+        break;
+#endif
+#if TPMS_PROTOCOL_ENABLE_FORD
+    case TPMSDecoderStatsProtocolFord:
+        ok = bench_build_ford(&builder);
+        break;
+#endif
+#if TPMS_PROTOCOL_ENABLE_GM
+    case TPMSDecoderStatsProtocolGm:
+        ok = bench_build_gm(&builder);
+        break;
+#endif
+#if TPMS_PROTOCOL_ENABLE_NISSAN
+    case TPMSDecoderStatsProtocolNissan:
+        ok = bench_build_nissan(&builder);
+        break;
+#endif
+#if TPMS_PROTOCOL_ENABLE_HYUNDAI
+    case TPMSDecoderStatsProtocolHyundai:
+        ok = bench_build_hyundai(&builder);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    if(!ok || builder.overflow) {
+        FURI_LOG_E(TAG, "stream %zu build failed", protocol_index);
+        return 0;
+    }
+    bench_push(&builder, false, TPMS_BENCHMARK_GAP_US);
+    return builder.overflow ? 0 : builder.count;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <furi.h>
+
+/** Edges are packed as level:1 | duration:31, level in the top bit */
+#define TPMS_BENCHMARK_EDGE_LEVEL_BIT 0x80000000UL
+
+/**
+ * Build the golden edge stream of one registered protocol: a single valid
+ * frame (preamble, sync and a payload with a correct checksum) followed by
+ * an out-of-alphabet gap that drops every decoder back to reset, so the
+ * stream can be replayed back to back.
+ * @param protocol_index Decoder-stats slot of the protocol; translate a
+ *        registry index with tpms_protocol_stats_slot() first
+ * @param edges Output buffer of packed edges
+ * @param max_edges Capacity of the output buffer
+ * @return number of edges written, 0 when the slot is unknown or the
+ *         buffer is too small
+ */
+size_t tpms_benchmark_stream_build(size_t protocol_index, uint32_t* edges, size_t max_edges);
@@ -0,0 +1,58 @@
+#include "tpms_burst_combine.h"
+
+// Candidates kept per protocol and the window one burst's repetitions
+// land in; three votes is the minimum for a meaningful majority
+#define TPMS_BURST_COMBINE_DEPTH 4
+#define TPMS_BURST_COMBINE_WINDOW_MS 250
+#define TPMS_BURST_COMBINE_MIN_VOTES 3
+
+typedef struct {
+    uint64_t data[TPMS_BURST_COMBINE_DEPTH];
+    uint32_t tick[TPMS_BURST_COMBINE_DEPTH];
+    uint8_t head; // next write slot
+    uint8_t count;
+} TPMSBurstCombineRing;
+
+static TPMSBurstCombineRing tpms_burst_combine_rings[TPMSDecoderStatsProtocolCount];
+
+bool tpms_burst_combine_push(TPMSDecoderStatsProtocol protocol, uint64_t data, uint64_t* voted) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    furi_assert(voted);
+    TPMSBurstCombineRing* ring = &tpms_burst_combine_rings[protocol];
+    uint32_t now = furi_get_tick();
+
+    // Age out leftovers of a previous burst
+    while(ring->count) {
+        uint8_t oldest =
+            (ring->head + TPMS_BURST_COMBINE_DEPTH - ring->count) % TPMS_BURST_COMBINE_DEPTH;
+        if((now - ring->tick[oldest]) <= TPMS_BURST_COMBINE_WINDOW_MS) break;
+        ring->count--;
+    }
+
+    ring->data[ring->head] = data;
+    ring->tick[ring->head] = now;
+    ring->head = (ring->head + 1) % TPMS_BURST_COMBINE_DEPTH;
+    if(ring->count < TPMS_BURST_COMBINE_DEPTH) ring->count++;
+
+    if(ring->count < TPMS_BURST_COMBINE_MIN_VOTES) return false;
+
+    // Bitwise majority across the live candidates; a tie keeps the bit
+    // clear, the caller's CRC check is the arbiter anyway
+    uint64_t result = 0;
+    for(uint8_t bit = 0; bit < 64; bit++) {
+        uint8_t ones = 0;
+        for(uint8_t i = 0; i < ring->count; i++) {
+            uint8_t slot =
+                (ring->head + TPMS_BURST_COMBINE_DEPTH - 1 - i) % TPMS_BURST_COMBINE_DEPTH;
+            ones += (ring->data[slot] >> bit) & 1;
+        }
+        if(ones * 2 > ring->count) result |= (1ULL << bit);
+    }
+    *voted = result;
+    return true;
+}
+
+void tpms_burst_combine_clear(TPMSDecoderStatsProtocol protocol) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    tpms_burst_combine_rings[protocol].count = 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <furi.h>
+#include "tpms_decoder_stats.h"
+
+/**
+ * Burst combining for weak transmissions. Sensors repeat each datagram
+ * several times per burst; near the edge of coverage every copy tends to
+ * carry a different corrupted bit, so each one fails its CRC alone. The
+ * CRC-failed candidates are kept in a small per-protocol ring and a
+ * bitwise majority vote across the repetitions of one burst often yields
+ * a frame that checks out.
+ */
+
+/** Record one CRC-failed frame and try the vote.
+ * Candidates older than the burst window are aged out first; the vote
+ * runs once enough repetitions of the current burst have been seen.
+ *
+ * @param protocol - decoder-stats slot owning the ring
+ * @param data - raw frame bits as accumulated by the decoder
+ * @param voted - receives the majority-voted bits on success
+ * @return true when a vote was taken, caller re-runs its CRC on voted
+ */
+bool tpms_burst_combine_push(TPMSDecoderStatsProtocol protocol, uint64_t data, uint64_t* voted);
+
+/** Drop the pending candidates of one protocol, called after a clean or
+ *  recovered decode so a finished burst cannot vote on the next one
+ *
+ * @param protocol - decoder-stats slot owning the ring
+ */
+void tpms_burst_combine_clear(TPMSDecoderStatsProtocol protocol);
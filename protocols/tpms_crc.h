@@ -0,0 +1,31 @@
+#pragma once
+
+#include <furi.h>
+
+/** Table-driven CRC-8, polynomial 0x07 (plain/ATM). One table lookup per
+ *  byte instead of eight shift/xor rounds
+ *
+ * @param data - bytes the CRC covers
+ * @param len - byte count
+ * @param init - initial CRC register value
+ * @return CRC-8 over data
+ */
+uint8_t tpms_crc8_0x07(const uint8_t* data, size_t len, uint8_t init);
+
+/** Table-driven CRC-8, polynomial 0x31 (Dallas/Maxim bit order as used
+ *  by the GM and Hyundai frames)
+ *
+ * @param data - bytes the CRC covers
+ * @param len - byte count
+ * @param init - initial CRC register value
+ * @return CRC-8 over data
+ */
+uint8_t tpms_crc8_0x31(const uint8_t* data, size_t len, uint8_t init);
+
+/** Modulo-256 byte sum, the Ford frame checksum
+ *
+ * @param data - bytes the sum covers
+ * @param len - byte count
+ * @return low byte of the sum
+ */
+uint8_t tpms_checksum8(const uint8_t* data, size_t len);
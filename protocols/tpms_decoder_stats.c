@@ -0,0 +1,15 @@
+#include "tpms_decoder_stats.h"
+
+#include <string.h>
+
+uint32_t tpms_decoder_stats[TPMSDecoderStatsProtocolCount][TPMSDecoderStatCount];
+
+uint32_t tpms_decoder_stats_get(TPMSDecoderStatsProtocol protocol, TPMSDecoderStat stat) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    furi_assert(stat < TPMSDecoderStatCount);
+    return tpms_decoder_stats[protocol][stat];
+}
+
+void tpms_decoder_stats_reset(void) {
+    memset(tpms_decoder_stats, 0, sizeof(tpms_decoder_stats));
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <furi.h>
+
+/** Counter slots, same order as tpms_protocol_registry_items */
+typedef enum {
+    TPMSDecoderStatsProtocolSchrader,
+    TPMSDecoderStatsProtocolToyota,
+    TPMSDecoderStatsProtocolFord,
+    TPMSDecoderStatsProtocolGm,
+    TPMSDecoderStatsProtocolNissan,
+    TPMSDecoderStatsProtocolHyundai,
+    TPMSDecoderStatsProtocolCount,
+} TPMSDecoderStatsProtocol;
+
+typedef enum {
+    TPMSDecoderStatEdges, ///< edges the front end attributed to this protocol
+    TPMSDecoderStatSyncs, ///< preamble/sync patterns matched
+    TPMSDecoderStatCrcErrors, ///< full frames dropped on checksum mismatch
+    TPMSDecoderStatFrames, ///< frames decoded and delivered
+    TPMSDecoderStatAborts, ///< data phases abandoned on a bad symbol
+    TPMSDecoderStatCount,
+} TPMSDecoderStat;
+
+extern uint32_t tpms_decoder_stats[TPMSDecoderStatsProtocolCount][TPMSDecoderStatCount];
+
+/** Bump one counter. Plain 32-bit increment so the decode-thread hot path
+ *  pays a single load/add/store; readers tolerate slightly stale totals
+ *
+ * @param protocol - registry slot of the decoder
+ * @param stat - counter to bump
+ */
+static inline void
+    tpms_decoder_stats_add(TPMSDecoderStatsProtocol protocol, TPMSDecoderStat stat) {
+    tpms_decoder_stats[protocol][stat]++;
+}
+
+/** Read one counter
+ *
+ * @param protocol - registry slot of the decoder
+ * @param stat - counter to read
+ * @return current count
+ */
+uint32_t tpms_decoder_stats_get(TPMSDecoderStatsProtocol protocol, TPMSDecoderStat stat);
+
+/** Zero all counters */
+void tpms_decoder_stats_reset(void);
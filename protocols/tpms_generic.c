@@ -21,6 +21,19 @@ void tpms_block_generic_get_preset_name(const char* preset_name, FuriString* pre
     furi_string_set(preset_str, preset_name_temp);
 }
 
+void tpms_format_fixed(char* output, size_t output_size, int32_t value, uint32_t scale) {
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-value) : (uint32_t)value;
+    int width = (scale >= 1000) ? 3 : (scale >= 100) ? 2 : 1;
+    snprintf(
+        output,
+        output_size,
+        "%s%lu.%0*lu",
+        (value < 0) ? "-" : "",
+        magnitude / scale,
+        width,
+        magnitude % scale);
+}
+
 SubGhzProtocolStatus tpms_block_generic_serialize(
     TPMSBlockGeneric* instance,
     FlipperFormat* flipper_format,
@@ -103,26 +116,27 @@ SubGhzProtocolStatus tpms_block_generic_serialize(
             break;
         }
 
-        float temp = instance->pressure;
+        // Key-file format keeps float fields, convert only here
+        float temp = (float)instance->pressure_mb / 1000.0f;
         if(!flipper_format_write_float(flipper_format, "Pressure", &temp, 1)) {
             FURI_LOG_E(TAG, "Unable to add Pressure");
             res = SubGhzProtocolStatusErrorParserOthers;
             break;
         }
 
-        //DATE AGE set
+        //DATE AGE set, keep the stored receive time when serializing later
         DateTime curr_dt;
         furi_hal_rtc_get_datetime(&curr_dt);
         uint32_t curr_ts = datetime_datetime_to_timestamp(&curr_dt);
 
-        temp_data = curr_ts;
+        temp_data = instance->timestamp ? instance->timestamp : curr_ts;
         if(!flipper_format_write_uint32(flipper_format, "Ts", &temp_data, 1)) {
             FURI_LOG_E(TAG, "Unable to add timestamp");
             res = SubGhzProtocolStatusErrorParserOthers;
             break;
         }
 
-        temp = instance->temperature;
+        temp = (float)instance->temperature_dc / 10.0f;
         if(!flipper_format_write_float(flipper_format, "Temp", &temp, 1)) {
             FURI_LOG_E(TAG, "Unable to add Temperature");
             res = SubGhzProtocolStatusErrorParserOthers;
@@ -186,7 +200,7 @@ SubGhzProtocolStatus
             res = SubGhzProtocolStatusErrorParserOthers;
             break;
         }
-        instance->pressure = temp;
+        instance->pressure_mb = (int32_t)(temp * 1000.0f + ((temp >= 0) ? 0.5f : -0.5f));
 
         if(!flipper_format_read_uint32(flipper_format, "Ts", &temp_data, 1)) {
             FURI_LOG_E(TAG, "Missing timestamp");
@@ -200,7 +214,7 @@ SubGhzProtocolStatus
             res = SubGhzProtocolStatusErrorParserOthers;
             break;
         }
-        instance->temperature = temp;
+        instance->temperature_dc = (int16_t)(temp * 10.0f + ((temp >= 0) ? 0.5f : -0.5f));
 
         res = SubGhzProtocolStatusOk;
     } while(0);
@@ -16,6 +16,10 @@ extern "C" {
 
 #define TPMS_NO_BATT 0xFF
 
+// Sensors without a temperature channel (or reporting it invalid) store
+// this marker instead of a reading
+#define TPMS_TEMPERATURE_INVALID_DC INT16_MIN
+
 typedef struct TPMSBlockGeneric TPMSBlockGeneric;
 
 struct TPMSBlockGeneric {
@@ -28,8 +32,13 @@ struct TPMSBlockGeneric {
     uint32_t id;
     uint8_t battery_low;
     // bool storage;
-    float pressure; // bar
-    float temperature; // celsius
+    // Readings are fixed point so the decode callback never touches the
+    // soft-float library; floats appear only at the key-file boundary
+    int32_t pressure_mb; // millibar
+    int16_t temperature_dc; // celsius * 10
+    // Set when the frame itself says the sensor is in relearn mode
+    // (Schrader status byte); protocols without such a flag leave it 0
+    uint8_t in_relearn;
 };
 
 /**
@@ -39,6 +48,15 @@ struct TPMSBlockGeneric {
      */
 void tpms_block_generic_get_preset_name(const char* preset_name, FuriString* preset_str);
 
+/**
+     * Render a fixed-point value as "<int>.<frac>" without float math.
+     * @param output Output buffer
+     * @param output_size Output buffer size
+     * @param value Value in units of 1/scale
+     * @param scale Power of ten: 10, 100 or 1000
+     */
+void tpms_format_fixed(char* output, size_t output_size, int32_t value, uint32_t scale);
+
 /**
      * Serialize data TPMSBlockGeneric.
      * @param instance Pointer to a TPMSBlockGeneric instance
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <lib/toolbox/manchester_decoder.h>
+
+/** Inline Manchester step kernel for the decoder feed loops.
+ *
+ * Semantics are identical to the toolbox manchester_advance(): same
+ * packed transition table, same self-transition reset, same reset state
+ * (ManchesterStateMid1). Being static inline it compiles straight into
+ * each feed's switch with the state held in a register across the event
+ * classification and transition — no external call per radio edge in the
+ * deepest loop of the app. The benchmark streams still search against
+ * the toolbox implementation, so any divergence shows up there as a
+ * zero-frame protocol.
+ *
+ * @param state - in/out Manchester state
+ * @param event - classified edge event, not ManchesterEventReset
+ * @param data - decoded bit, valid when true is returned
+ * @return true when a bit was emitted
+ */
+static inline bool
+    tpms_manchester_advance(ManchesterState* state, ManchesterEvent event, bool* data) {
+    // Each byte holds four 2-bit next-states indexed by event/2
+    static const uint8_t tpms_manchester_transitions[] = {
+        0b00000001,
+        0b10010001,
+        0b10011011,
+        0b11111011,
+    };
+
+    bool result = false;
+    ManchesterState new_state;
+
+    if(event == ManchesterEventReset) {
+        new_state = ManchesterStateMid1;
+    } else {
+        new_state = (tpms_manchester_transitions[*state] >> event) & 0x3;
+        if(new_state == *state) {
+            new_state = ManchesterStateMid1;
+        } else if(new_state == ManchesterStateMid0) {
+            *data = false;
+            result = true;
+        } else if(new_state == ManchesterStateMid1) {
+            *data = true;
+            result = true;
+        }
+    }
+
+    *state = new_state;
+    return result;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+/** Compile-time protocol selection profiles.
+ *
+ *  Fleet builds pass one profile define through cdefines in
+ *  application.fam; without one the full registry is compiled in. An
+ *  excluded decoder drops out of the FAP entirely: its translation unit
+ *  compiles to nothing, subghz_receiver_alloc_init() never allocates its
+ *  state and the front-end fan-out has one mask bit less to test.
+ *
+ *  Registry order (and therefore front-end mask bits and the session-log
+ *  protocol index) is profile-dependent; the decoder-stats slots stay
+ *  fixed, translated via tpms_protocol_stats_slot().
+ */
+
+#if defined(TPMS_PROFILE_US)
+// US fleet: Schrader GG4 covers the EU variants only
+#define TPMS_PROTOCOL_ENABLE_SCHRADER 0
+#define TPMS_PROTOCOL_ENABLE_TOYOTA 1
+#define TPMS_PROTOCOL_ENABLE_FORD 1
+#define TPMS_PROTOCOL_ENABLE_GM 1
+#define TPMS_PROTOCOL_ENABLE_NISSAN 1
+#define TPMS_PROTOCOL_ENABLE_HYUNDAI 1
+#elif defined(TPMS_PROFILE_EU)
+// EU fleet: GM's 315 MHz scheme never shows up
+#define TPMS_PROTOCOL_ENABLE_SCHRADER 1
+#define TPMS_PROTOCOL_ENABLE_TOYOTA 1
+#define TPMS_PROTOCOL_ENABLE_FORD 1
+#define TPMS_PROTOCOL_ENABLE_GM 0
+#define TPMS_PROTOCOL_ENABLE_NISSAN 1
+#define TPMS_PROTOCOL_ENABLE_HYUNDAI 1
+#else
+// TPMS_PROFILE_ALL, the default
+#define TPMS_PROTOCOL_ENABLE_SCHRADER 1
+#define TPMS_PROTOCOL_ENABLE_TOYOTA 1
+#define TPMS_PROTOCOL_ENABLE_FORD 1
+#define TPMS_PROTOCOL_ENABLE_GM 1
+#define TPMS_PROTOCOL_ENABLE_NISSAN 1
+#define TPMS_PROTOCOL_ENABLE_HYUNDAI 1
+#endif
@@ -0,0 +1,123 @@
+#include "tpms_timing_cal.h"
+
+#include <storage/storage.h>
+
+#define TAG "TPMSTimingCal"
+
+#define TPMS_TIMING_CAL_DIR EXT_PATH("apps_data/tpms")
+#define TPMS_TIMING_CAL_PATH TPMS_TIMING_CAL_DIR "/timing.cal"
+#define TPMS_TIMING_CAL_MAGIC 0x4C435054 // "TPCL"
+#define TPMS_TIMING_CAL_VERSION 1
+
+// Symbols needed before a frame's mean error may nudge the offset, and
+// the EMA divisor of the nudge itself; slow convergence keeps one noisy
+// frame from dragging the windows around
+#define TPMS_TIMING_CAL_MIN_SYMBOLS 8
+#define TPMS_TIMING_CAL_NUDGE_DIV 4
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t offset[TPMSDecoderStatsProtocolCount];
+} TPMSTimingCalFile;
+
+typedef struct {
+    int32_t offset;
+    int32_t pending_sum;
+    uint16_t pending_count;
+} TPMSTimingCalState;
+
+static TPMSTimingCalState tpms_timing_cal_state[TPMSDecoderStatsProtocolCount];
+static bool tpms_timing_cal_dirty;
+
+int32_t tpms_timing_cal_offset(TPMSDecoderStatsProtocol protocol) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    return tpms_timing_cal_state[protocol].offset;
+}
+
+uint32_t tpms_timing_cal_apply(TPMSDecoderStatsProtocol protocol, uint32_t duration) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    int32_t shifted = (int32_t)duration - tpms_timing_cal_state[protocol].offset;
+    return (shifted > 0) ? (uint32_t)shifted : 1;
+}
+
+void tpms_timing_cal_note(TPMSDecoderStatsProtocol protocol, int32_t error) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    TPMSTimingCalState* state = &tpms_timing_cal_state[protocol];
+    state->pending_sum += error;
+    if(state->pending_count < UINT16_MAX) state->pending_count++;
+}
+
+void tpms_timing_cal_frame_good(TPMSDecoderStatsProtocol protocol) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    TPMSTimingCalState* state = &tpms_timing_cal_state[protocol];
+    if(state->pending_count >= TPMS_TIMING_CAL_MIN_SYMBOLS) {
+        int32_t mean = state->pending_sum / (int32_t)state->pending_count;
+        int32_t offset = state->offset + mean / TPMS_TIMING_CAL_NUDGE_DIV;
+        if(offset > TPMS_TIMING_CAL_MAX_OFFSET) offset = TPMS_TIMING_CAL_MAX_OFFSET;
+        if(offset < -TPMS_TIMING_CAL_MAX_OFFSET) offset = -TPMS_TIMING_CAL_MAX_OFFSET;
+        if(offset != state->offset) {
+            state->offset = offset;
+            tpms_timing_cal_dirty = true;
+            FURI_LOG_D(TAG, "slot %u offset %ldus", protocol, state->offset);
+        }
+    }
+    state->pending_sum = 0;
+    state->pending_count = 0;
+}
+
+void tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocol protocol) {
+    furi_assert(protocol < TPMSDecoderStatsProtocolCount);
+    tpms_timing_cal_state[protocol].pending_sum = 0;
+    tpms_timing_cal_state[protocol].pending_count = 0;
+}
+
+void tpms_timing_cal_load(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    if(storage_file_open(file, TPMS_TIMING_CAL_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        TPMSTimingCalFile data;
+        if(storage_file_read(file, &data, sizeof(data)) == sizeof(data) &&
+           data.magic == TPMS_TIMING_CAL_MAGIC && data.version == TPMS_TIMING_CAL_VERSION) {
+            for(size_t i = 0; i < TPMSDecoderStatsProtocolCount; i++) {
+                int32_t offset = data.offset[i];
+                // Defend against a hand-edited or stale file
+                if(offset > TPMS_TIMING_CAL_MAX_OFFSET) offset = TPMS_TIMING_CAL_MAX_OFFSET;
+                if(offset < -TPMS_TIMING_CAL_MAX_OFFSET) offset = -TPMS_TIMING_CAL_MAX_OFFSET;
+                tpms_timing_cal_state[i].offset = offset;
+            }
+            FURI_LOG_I(TAG, "Loaded timing offsets");
+        }
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    tpms_timing_cal_dirty = false;
+}
+
+bool tpms_timing_cal_save(void) {
+    if(!tpms_timing_cal_dirty) return true;
+
+    TPMSTimingCalFile data = {
+        .magic = TPMS_TIMING_CAL_MAGIC,
+        .version = TPMS_TIMING_CAL_VERSION,
+    };
+    for(size_t i = 0; i < TPMSDecoderStatsProtocolCount; i++) {
+        data.offset[i] = tpms_timing_cal_state[i].offset;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_common_mkdir(storage, TPMS_TIMING_CAL_DIR);
+    File* file = storage_file_alloc(storage);
+    bool ok = storage_file_open(file, TPMS_TIMING_CAL_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    if(ok) {
+        ok = storage_file_write(file, &data, sizeof(data)) == sizeof(data);
+        storage_file_close(file);
+        tpms_timing_cal_dirty = !ok;
+    } else {
+        FURI_LOG_E(TAG, "Failed to open %s", TPMS_TIMING_CAL_PATH);
+    }
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return ok;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <furi.h>
+#include "tpms_decoder_stats.h"
+
+/**
+ * Per-site timing calibration. The te_short/te_long windows are
+ * compile-time nominals, but sensor clock tolerance plus the external
+ * CC1101's timing skew can park a vehicle right at a window edge where
+ * it decodes only intermittently. Each decoder reports the duration
+ * error of the symbols of every frame that passed its CRC; the learned
+ * per-protocol offset shifts incoming durations back toward the nominal
+ * centers within a bounded range, and persists across launches so a
+ * site's skew is corrected from the first frame.
+ */
+
+/** Largest correction ever applied, microseconds; stays well inside the
+ *  tightest te_delta so calibration can never widen a window into a
+ *  neighbouring symbol */
+#define TPMS_TIMING_CAL_MAX_OFFSET 40
+
+/** Learned offset of one protocol, microseconds */
+int32_t tpms_timing_cal_offset(TPMSDecoderStatsProtocol protocol);
+
+/** Shift a raw duration by the learned offset before classification */
+uint32_t tpms_timing_cal_apply(TPMSDecoderStatsProtocol protocol, uint32_t duration);
+
+/** Record the residual error of one classified symbol, calibrated
+ *  duration minus the nominal te it matched. Held pending until the
+ *  frame's CRC verdict is known
+ *
+ * @param protocol - decoder-stats slot of the decoder
+ * @param error - signed residual in microseconds
+ */
+void tpms_timing_cal_note(TPMSDecoderStatsProtocol protocol, int32_t error);
+
+/** Commit the pending symbol errors into the offset, called on a frame
+ *  that passed its CRC — only verified frames may steer the windows */
+void tpms_timing_cal_frame_good(TPMSDecoderStatsProtocol protocol);
+
+/** Drop the pending symbol errors, called on CRC failure or abort */
+void tpms_timing_cal_frame_drop(TPMSDecoderStatsProtocol protocol);
+
+/** Load the persisted offsets from SD, called once at startup */
+void tpms_timing_cal_load(void);
+
+/** Persist the offsets when they changed since the last save
+ * @return true on success or nothing to do
+ */
+bool tpms_timing_cal_save(void);
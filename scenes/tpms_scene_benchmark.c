@@ -0,0 +1,161 @@
+#include "../tpms_app_i.h"
+#include "../protocols/protocol_items.h"
+#include "../protocols/tpms_decoder_stats.h"
+#include "../protocols/tpms_benchmark_streams.h"
+
+#define TAG "TPMSSceneBenchmark"
+
+// One frame per protocol fits comfortably; Manchester search may spend up
+// to three edges per bit
+#define TPMS_BENCHMARK_MAX_EDGES 1024
+
+// Replay window per protocol, long enough for a stable rate
+#define TPMS_BENCHMARK_SLICE_MS 250
+
+typedef struct {
+    SubGhzEnvironment* environment;
+    SubGhzReceiver* receiver;
+    uint32_t* edges;
+    volatile uint32_t decoded;
+    size_t current;
+    uint32_t edges_per_sec[TPMSDecoderStatsProtocolCount];
+    uint32_t decodes_per_sec[TPMSDecoderStatsProtocolCount];
+} TPMSBenchmark;
+
+static TPMSBenchmark* tpms_benchmark;
+
+static void tpms_scene_benchmark_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    TPMSBenchmark* benchmark = context;
+    benchmark->decoded++;
+}
+
+static void tpms_scene_benchmark_update(TPMSApp* app) {
+    widget_reset(app->widget);
+
+    widget_add_text_box_element(
+        app->widget,
+        0,
+        2,
+        128,
+        14,
+        AlignCenter,
+        AlignBottom,
+        "\e#\e!          Benchmark          \e!\n",
+        false);
+
+    FuriString* temp_str;
+    temp_str = furi_string_alloc();
+
+    size_t protocol_count = subghz_protocol_registry_count(&tpms_protocol_registry);
+    for(size_t i = 0; i < protocol_count; ++i) {
+        const SubGhzProtocol* protocol =
+            subghz_protocol_registry_get_by_index(&tpms_protocol_registry, i);
+        if(i < tpms_benchmark->current) {
+            furi_string_cat_printf(
+                temp_str,
+                "\e#%s\nEdges/s: %lu\nFrames/s: %lu\n",
+                protocol->name,
+                tpms_benchmark->edges_per_sec[i],
+                tpms_benchmark->decodes_per_sec[i]);
+        } else if(i == tpms_benchmark->current) {
+            furi_string_cat_printf(temp_str, "\e#%s\nrunning...\n", protocol->name);
+        } else {
+            furi_string_cat_printf(temp_str, "\e#%s\npending\n", protocol->name);
+        }
+    }
+
+    widget_add_text_scroll_element(app->widget, 0, 16, 128, 50, furi_string_get_cstr(temp_str));
+    furi_string_free(temp_str);
+}
+
+static void tpms_scene_benchmark_step(TPMSApp* app) {
+    TPMSBenchmark* benchmark = tpms_benchmark;
+    size_t idx = benchmark->current;
+
+    size_t count = tpms_benchmark_stream_build(
+        tpms_protocol_stats_slot(idx), benchmark->edges, TPMS_BENCHMARK_MAX_EDGES);
+    uint32_t fed = 0;
+    benchmark->decoded = 0;
+
+    uint32_t start = furi_get_tick();
+    if(count) {
+        while(furi_get_tick() - start < TPMS_BENCHMARK_SLICE_MS) {
+            for(size_t i = 0; i < count; i++) {
+                uint32_t packed = benchmark->edges[i];
+                subghz_receiver_decode(
+                    benchmark->receiver,
+                    (packed & TPMS_BENCHMARK_EDGE_LEVEL_BIT) != 0,
+                    packed & ~TPMS_BENCHMARK_EDGE_LEVEL_BIT);
+            }
+            fed += count;
+        }
+    }
+    uint32_t elapsed = furi_get_tick() - start;
+    if(!elapsed) elapsed = 1;
+
+    benchmark->edges_per_sec[idx] = (uint32_t)((uint64_t)fed * 1000 / elapsed);
+    benchmark->decodes_per_sec[idx] = (uint32_t)((uint64_t)benchmark->decoded * 1000 / elapsed);
+    FURI_LOG_I(
+        TAG,
+        "%zu: %lu edges/s %lu frames/s",
+        idx,
+        benchmark->edges_per_sec[idx],
+        benchmark->decodes_per_sec[idx]);
+    benchmark->current++;
+
+    tpms_scene_benchmark_update(app);
+}
+
+void tpms_scene_benchmark_on_enter(void* context) {
+    TPMSApp* app = context;
+
+    // The benchmark loads the CPU; keep the radio path quiet meanwhile
+    if(app->txrx->txrx_state == TPMSTxRxStateRx) {
+        tpms_rx_end(app);
+    }
+
+    tpms_benchmark = malloc(sizeof(TPMSBenchmark));
+    tpms_benchmark->edges = malloc(TPMS_BENCHMARK_MAX_EDGES * sizeof(uint32_t));
+    tpms_benchmark->environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(
+        tpms_benchmark->environment, (void*)&tpms_protocol_registry);
+    tpms_benchmark->receiver = subghz_receiver_alloc_init(tpms_benchmark->environment);
+    subghz_receiver_set_filter(tpms_benchmark->receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(
+        tpms_benchmark->receiver, tpms_scene_benchmark_rx_callback, tpms_benchmark);
+
+    tpms_scene_benchmark_update(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, TPMSViewWidget);
+}
+
+bool tpms_scene_benchmark_on_event(void* context, SceneManagerEvent event) {
+    TPMSApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeTick) {
+        if(tpms_benchmark->current < subghz_protocol_registry_count(&tpms_protocol_registry)) {
+            tpms_scene_benchmark_step(app);
+        }
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void tpms_scene_benchmark_on_exit(void* context) {
+    TPMSApp* app = context;
+
+    // Clear views
+    widget_reset(app->widget);
+
+    subghz_receiver_free(tpms_benchmark->receiver);
+    subghz_environment_free(tpms_benchmark->environment);
+    free(tpms_benchmark->edges);
+    free(tpms_benchmark);
+    tpms_benchmark = NULL;
+}
@@ -2,6 +2,11 @@ ADD_SCENE(tpms, start, Start)
 ADD_SCENE(tpms, about, About)
 ADD_SCENE(tpms, config_guide, ConfigGuide)
 ADD_SCENE(tpms, receiver, Receiver)
+ADD_SCENE(tpms, preset_detect, PresetDetect)
 ADD_SCENE(tpms, relearn_config, Relearn)
 ADD_SCENE(tpms, receiver_config, ReceiverConfig)
 ADD_SCENE(tpms, receiver_info, ReceiverInfo)
+ADD_SCENE(tpms, sweep, Sweep)
+ADD_SCENE(tpms, stats, Stats)
+ADD_SCENE(tpms, benchmark, Benchmark)
+ADD_SCENE(tpms, sensor_name, SensorName)
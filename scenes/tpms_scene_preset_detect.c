@@ -0,0 +1,235 @@
+#include "../tpms_app_i.h"
+#include "../protocols/protocol_items.h"
+#include "../protocols/tpms_decoder_stats.h"
+
+#define TAG "TPMSSceneDetect"
+
+// Dwell per preset in dispatcher ticks (~100 ms each); sensors repeat
+// their burst several times, 600 ms catches at least one repetition
+#define TPMS_DETECT_DWELL_TICKS 6
+
+// Score that locks a preset: edges the front end put into a protocol's
+// pulse alphabet plus heavily weighted preamble syncs. One real preamble
+// scores a sync and tens of edges; noise rarely crosses this
+#define TPMS_DETECT_SYNC_WEIGHT 50
+#define TPMS_DETECT_LOCK_SCORE 80
+
+#define TPMS_DETECT_MAX_PROTOCOLS 8
+
+typedef struct {
+    uint8_t entry_preset_idx;
+    uint8_t preset_idx;
+    uint8_t dwell_tick;
+    uint8_t round;
+    bool radio_started;
+    bool locked;
+    // Stat counters at the start of the current dwell; the front end
+    // keeps counting while other scenes run, so only deltas mean anything
+    uint32_t edges_base[TPMS_DETECT_MAX_PROTOCOLS];
+    uint32_t syncs_base[TPMS_DETECT_MAX_PROTOCOLS];
+    uint32_t best_score;
+    uint8_t best_preset_idx;
+    uint8_t best_protocol_idx;
+} TPMSDetectState;
+
+static TPMSDetectState* tpms_detect_state;
+
+static void tpms_scene_preset_detect_update_widget(TPMSApp* app) {
+    TPMSDetectState* state = tpms_detect_state;
+    widget_reset(app->widget);
+
+    widget_add_text_box_element(
+        app->widget,
+        0,
+        2,
+        128,
+        14,
+        AlignCenter,
+        AlignBottom,
+        "\e#\e!         Preset Detect         \e!\n",
+        false);
+
+    FuriString* temp_str;
+    temp_str = furi_string_alloc();
+    if(state->locked) {
+        furi_string_printf(
+            temp_str,
+            "Burst detected!\nLooks like %s /\n%s\n\nPreset locked, back out\nand Read TPMS",
+            tpms_setting_get_preset_name(app->setting, state->best_preset_idx),
+            subghz_protocol_registry_get_by_index(&tpms_protocol_registry, state->best_protocol_idx)
+                ->name);
+    } else if(!state->radio_started) {
+        furi_string_printf(temp_str, "Waiting for radio...");
+    } else {
+        furi_string_printf(
+            temp_str,
+            "Listening %s\nPass %u\n",
+            tpms_setting_get_preset_name(app->setting, state->preset_idx),
+            state->round + 1);
+        if(state->best_score) {
+            furi_string_cat_printf(
+                temp_str,
+                "Best so far: %s /\n%s (%lu)",
+                tpms_setting_get_preset_name(app->setting, state->best_preset_idx),
+                subghz_protocol_registry_get_by_index(
+                    &tpms_protocol_registry, state->best_protocol_idx)
+                    ->name,
+                state->best_score);
+        } else {
+            furi_string_cat_printf(temp_str, "No burst yet, drive the\ncar or trigger relearn");
+        }
+    }
+    widget_add_text_scroll_element(app->widget, 0, 16, 128, 48, furi_string_get_cstr(temp_str));
+    furi_string_free(temp_str);
+}
+
+static void tpms_scene_preset_detect_snapshot(void) {
+    TPMSDetectState* state = tpms_detect_state;
+    for(size_t i = 0; i < subghz_protocol_registry_count(&tpms_protocol_registry); i++) {
+        state->edges_base[i] = tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatEdges);
+        state->syncs_base[i] = tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatSyncs);
+    }
+}
+
+// Close the dwell window on the current preset: score each protocol by
+// how many edges the front end classified into its pulse alphabet and
+// how many preambles synced, CRC-valid or not
+static void tpms_scene_preset_detect_score(void) {
+    TPMSDetectState* state = tpms_detect_state;
+    for(size_t i = 0; i < subghz_protocol_registry_count(&tpms_protocol_registry); i++) {
+        uint32_t edges =
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatEdges) -
+            state->edges_base[i];
+        uint32_t syncs =
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatSyncs) -
+            state->syncs_base[i];
+        uint32_t score = edges + syncs * TPMS_DETECT_SYNC_WEIGHT;
+        if(score > state->best_score) {
+            state->best_score = score;
+            state->best_preset_idx = state->preset_idx;
+            state->best_protocol_idx = i;
+        }
+    }
+}
+
+static void tpms_scene_preset_detect_tune(TPMSApp* app, uint8_t preset_idx) {
+    if(app->txrx->txrx_state == TPMSTxRxStateRx) {
+        tpms_rx_end(app);
+    }
+    tpms_preset_init(
+        app,
+        tpms_setting_get_preset_name(app->setting, preset_idx),
+        app->txrx->preset->frequency,
+        tpms_setting_get_preset_data(app->setting, preset_idx),
+        tpms_setting_get_preset_data_size(app->setting, preset_idx));
+    tpms_begin(app, tpms_setting_get_preset_data(app->setting, preset_idx));
+    tpms_rx(app, app->txrx->preset->frequency);
+}
+
+void tpms_scene_preset_detect_on_enter(void* context) {
+    TPMSApp* app = context;
+
+    tpms_detect_state = malloc(sizeof(TPMSDetectState));
+    for(size_t i = 0; i < tpms_setting_get_preset_count(app->setting); i++) {
+        if(!strcmp(
+               tpms_setting_get_preset_name(app->setting, i),
+               furi_string_get_cstr(app->txrx->preset->name))) {
+            tpms_detect_state->entry_preset_idx = i;
+            break;
+        }
+    }
+
+    tpms_hopper_set_state(app, TPMSHopperStateOFF);
+    if(app->txrx->txrx_state == TPMSTxRxStateRx) {
+        tpms_rx_end(app);
+    }
+
+    tpms_scene_preset_detect_update_widget(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, TPMSViewWidget);
+}
+
+bool tpms_scene_preset_detect_on_event(void* context, SceneManagerEvent event) {
+    TPMSApp* app = context;
+    TPMSDetectState* state = tpms_detect_state;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == TPMSCustomEventRadioReady) {
+            consumed = true;
+        }
+    } else if(event.type == SceneManagerEventTypeTick) {
+        if(!app->txrx->radio_ready || state->locked) return consumed;
+
+        // Wait out the radio probe thread, then claim the radio once
+        if(!state->radio_started) {
+            state->preset_idx = 0;
+            tpms_scene_preset_detect_tune(app, state->preset_idx);
+            tpms_scene_preset_detect_snapshot();
+            state->radio_started = true;
+            tpms_scene_preset_detect_update_widget(app);
+            return consumed;
+        }
+
+        if(++state->dwell_tick < TPMS_DETECT_DWELL_TICKS) return consumed;
+        state->dwell_tick = 0;
+
+        tpms_scene_preset_detect_score();
+
+        // A full pass over the presets is the decision point, so a burst
+        // on a late preset cannot lose to one scored on an earlier pass
+        if(state->preset_idx + 1 >= tpms_setting_get_preset_count(app->setting)) {
+            if(state->best_score >= TPMS_DETECT_LOCK_SCORE) {
+                state->locked = true;
+                tpms_scene_preset_detect_tune(app, state->best_preset_idx);
+                // Keeps the receiver scene from resetting the preset to
+                // the default on its next fresh entry
+                app->txrx->rx_key_state = TPMSRxKeyStateStart;
+                notification_message(app->notifications, &sequence_success);
+                tpms_scene_preset_detect_update_widget(app);
+                FURI_LOG_I(
+                    TAG,
+                    "Locked %s, protocol %s, score %lu",
+                    tpms_setting_get_preset_name(app->setting, state->best_preset_idx),
+                    subghz_protocol_registry_get_by_index(
+                        &tpms_protocol_registry, state->best_protocol_idx)
+                        ->name,
+                    state->best_score);
+                return consumed;
+            }
+            state->preset_idx = 0;
+            state->round++;
+        } else {
+            state->preset_idx++;
+        }
+
+        tpms_scene_preset_detect_tune(app, state->preset_idx);
+        tpms_scene_preset_detect_snapshot();
+        tpms_scene_preset_detect_update_widget(app);
+    }
+    return consumed;
+}
+
+void tpms_scene_preset_detect_on_exit(void* context) {
+    TPMSApp* app = context;
+
+    if(app->txrx->txrx_state == TPMSTxRxStateRx) {
+        tpms_rx_end(app);
+    }
+    if(tpms_detect_state->radio_started) {
+        tpms_sleep(app);
+    }
+    // A locked preset stays for the receiver; otherwise put back what the
+    // scene found on entry
+    if(!tpms_detect_state->locked) {
+        uint8_t idx = tpms_detect_state->entry_preset_idx;
+        tpms_preset_init(
+            app,
+            tpms_setting_get_preset_name(app->setting, idx),
+            app->txrx->preset->frequency,
+            tpms_setting_get_preset_data(app->setting, idx),
+            tpms_setting_get_preset_data_size(app->setting, idx));
+    }
+    free(tpms_detect_state);
+    tpms_detect_state = NULL;
+    widget_reset(app->widget);
+}
@@ -1,5 +1,6 @@
 #include "../tpms_app_i.h"
 #include "../views/tpms_receiver.h"
+#include "../protocols/protocol_items.h"
 
 static const NotificationSequence subghz_sequence_rx = {
     &message_green_255,
@@ -14,6 +15,25 @@ static const NotificationSequence subghz_sequence_rx = {
     NULL,
 };
 
+static const NotificationSequence tpms_sequence_alert = {
+    &message_red_255,
+
+    &message_display_backlight_on,
+
+    &message_vibro_on,
+    &message_note_c5,
+    &message_delay_100,
+    &message_sound_off,
+    &message_delay_50,
+    &message_note_c5,
+    &message_delay_100,
+    &message_sound_off,
+    &message_vibro_off,
+
+    &message_delay_50,
+    NULL,
+};
+
 static const NotificationSequence subghz_sequence_rx_locked = {
     &message_green_255,
 
@@ -31,6 +51,24 @@ static const NotificationSequence subghz_sequence_rx_locked = {
     NULL,
 };
 
+// Frequency last pushed into the status bar, so the tick can tell when
+// the hopper thread has moved the radio since the previous redraw
+static uint32_t tpms_scene_receiver_shown_frequency;
+
+// Set while the relearn LED blink is on, so the tick can turn it off
+// when a one-shot burst finishes on its own
+static bool tpms_scene_receiver_relearn_blink;
+
+// Sensors answer within a few seconds of the LF trigger; frames landing
+// inside this window after a burst starts count as the pairing answer
+#define TPMS_RELEARN_CAPTURE_WINDOW_MS 10000
+
+// Tick deadline of the armed capture window, 0 when disarmed. Armed by
+// the relearn toggle, consumed by the first fresh ID (or a frame that
+// flags relearn state itself), so the pairing opens the info view
+// instead of being hunted down in the list
+static uint32_t tpms_scene_receiver_capture_until;
+
 static void tpms_scene_receiver_update_statusbar(void* context) {
     TPMSApp* app = context;
     FuriString* history_stat_str;
@@ -49,7 +87,7 @@ static void tpms_scene_receiver_update_statusbar(void* context) {
             furi_string_get_cstr(frequency_str),
             furi_string_get_cstr(modulation_str),
             furi_string_get_cstr(history_stat_str),
-            radio_device_loader_is_external(app->txrx->radio_device));
+            app->txrx->radio_device && radio_device_loader_is_external(app->txrx->radio_device));
 
         furi_string_free(frequency_str);
         furi_string_free(modulation_str);
@@ -59,11 +97,38 @@ static void tpms_scene_receiver_update_statusbar(void* context) {
             furi_string_get_cstr(history_stat_str),
             "",
             "",
-            radio_device_loader_is_external(app->txrx->radio_device));
+            app->txrx->radio_device && radio_device_loader_is_external(app->txrx->radio_device));
     }
     furi_string_free(history_stat_str);
 }
 
+// Point the receiver menu at the history, used on scene enter. The view
+// renders straight from the store, so there is nothing to copy over
+static void tpms_scene_receiver_load_history(TPMSApp* app) {
+    tpms_view_receiver_set_history(app->tpms_receiver, app->txrx->history);
+    if(tpms_history_get_item(app->txrx->history)) {
+        app->txrx->rx_key_state = TPMSRxKeyStateAddKey;
+    }
+}
+
+// Right toggles a relearn burst: a second press while the coil is still
+// keying stops it, otherwise the configured pattern starts
+static void tpms_scene_receiver_relearn_toggle(TPMSApp* app, bool rapid) {
+    if(app->relearn != TPMSRelearnOn) return;
+    if(tpms_relearn_worker_is_running(app->relearn_worker)) {
+        tpms_relearn_worker_stop(app->relearn_worker);
+        notification_message(app->notifications, &sequence_blink_stop);
+        tpms_scene_receiver_relearn_blink = false;
+        // Aborting the burst abandons the pairing attempt too
+        tpms_scene_receiver_capture_until = 0;
+    } else if(tpms_relearn_worker_start(app->relearn_worker, app->relearn_type, rapid)) {
+        notification_message(app->notifications, &sequence_blink_start_red);
+        tpms_scene_receiver_relearn_blink = true;
+        tpms_scene_receiver_capture_until =
+            furi_get_tick() + furi_ms_to_ticks(TPMS_RELEARN_CAPTURE_WINDOW_MS);
+    }
+}
+
 void tpms_scene_receiver_callback(TPMSCustomEvent event, void* context) {
     furi_assert(context);
     TPMSApp* app = context;
@@ -76,20 +141,71 @@ static void tpms_scene_receiver_add_to_history_callback(
     void* context) {
     furi_assert(context);
     TPMSApp* app = context;
-    FuriString* str_buff;
-    str_buff = furi_string_alloc();
 
-    if(tpms_history_add_to_history(app->txrx->history, decoder_base, app->txrx->preset) ==
-       TPMSHistoryStateAddKeyNewDada) {
-        furi_string_reset(str_buff);
+    // Any decoded frame marks the current hopper frequency as productive
+    tpms_hopper_register_hit(app);
 
-        tpms_history_get_text_item_menu(
-            app->txrx->history, str_buff, tpms_history_get_item(app->txrx->history) - 1);
-        tpms_view_receiver_add_item_to_menu(
-            app->tpms_receiver,
-            furi_string_get_cstr(str_buff),
-            tpms_history_get_type_protocol(
-                app->txrx->history, tpms_history_get_item(app->txrx->history) - 1));
+    // Provenance: frames from the second radio carry its preset, so the
+    // recorded frequency tells which band/radio captured them
+    SubGhzRadioPreset* preset = (receiver == app->txrx->receiver_second) ?
+                                    app->txrx->preset_second :
+                                    app->txrx->preset;
+
+    TPMSHistoryStateAddKey state =
+        tpms_history_add_to_history(app->txrx->history, decoder_base, preset);
+    if(state == TPMSHistoryStateAddKeyNewDada || state == TPMSHistoryStateAddKeyUpdateData ||
+       state == TPMSHistoryStateAddKeyOverwrite) {
+        tpms_session_log_append(app->session_log, decoder_base, preset);
+        tpms_stream_push(app->stream, decoder_base, preset);
+
+        // Threshold check right on the update, no polling between a frame
+        // arriving and the alert firing
+        uint16_t record_idx;
+        const TPMSBlockGeneric* generic = tpms_protocol_get_generic(decoder_base);
+        if(generic && tpms_history_find_by_id(app->txrx->history, generic->id, &record_idx)) {
+            const TPMSHistoryRecord* record =
+                tpms_history_get_record(app->txrx->history, record_idx);
+            TPMSTrendSample trend[TPMS_HISTORY_TREND_DEPTH];
+            uint8_t trend_count = tpms_history_get_trend(
+                app->txrx->history, record_idx, trend, TPMS_HISTORY_TREND_DEPTH);
+            if(tpms_alert_check(app->alert, record, trend, trend_count) != TPMSAlertEventNone) {
+                notification_message(app->notifications, &tpms_sequence_alert);
+            }
+
+            uint8_t protocol_index = 0xFF;
+            for(size_t i = 0; i < subghz_protocol_registry_count(&tpms_protocol_registry); i++) {
+                if(subghz_protocol_registry_get_by_index(&tpms_protocol_registry, i) ==
+                   decoder_base->protocol) {
+                    protocol_index = i;
+                    break;
+                }
+            }
+            tpms_sensor_db_touch(
+                app->sensor_db,
+                generic->id,
+                (int16_t)(record->pressure_mb / 10),
+                record->temperature_dc,
+                record->timestamp,
+                protocol_index);
+            tpms_monitor_note_frame(app, generic->id, record->timestamp);
+
+            // Inside the relearn capture window a fresh ID - or any frame
+            // flagging relearn state itself - is the pairing answer: jump
+            // straight to its info view instead of scrolling for it
+            if(tpms_scene_receiver_capture_until &&
+               furi_get_tick() < tpms_scene_receiver_capture_until &&
+               (state == TPMSHistoryStateAddKeyNewDada || generic->in_relearn)) {
+                tpms_scene_receiver_capture_until = 0;
+                app->txrx->idx_menu_chosen = record_idx;
+                view_dispatcher_send_custom_event(
+                    app->view_dispatcher, TPMSCustomEventSceneRelearnCapture);
+            }
+        }
+    }
+    if(state == TPMSHistoryStateAddKeyNewDada || state == TPMSHistoryStateAddKeyOverwrite) {
+        // The view renders from the history itself; the generation bump
+        // already invalidated its cache, just refresh count and cursor
+        tpms_view_receiver_update(app->tpms_receiver);
 
         tpms_scene_receiver_update_statusbar(app);
         notification_message(app->notifications, &sequence_blink_green_10);
@@ -100,19 +216,15 @@ static void tpms_scene_receiver_add_to_history_callback(
         }
     }
     subghz_receiver_reset(receiver);
-    furi_string_free(str_buff);
     app->txrx->rx_key_state = TPMSRxKeyStateAddKey;
 }
 
 void tpms_scene_receiver_on_enter(void* context) {
     TPMSApp* app = context;
 
-    FuriString* str_buff;
-    str_buff = furi_string_alloc();
-
     if(app->txrx->rx_key_state == TPMSRxKeyStateIDLE) {
         tpms_preset_init(
-            app, "AM650", subghz_setting_get_default_frequency(app->setting), NULL, 0);
+            app, "AM650", tpms_setting_get_default_frequency(app->setting), NULL, 0);
         tpms_history_reset(app->txrx->history);
         app->txrx->rx_key_state = TPMSRxKeyStateStart;
     }
@@ -120,31 +232,27 @@ void tpms_scene_receiver_on_enter(void* context) {
     tpms_view_receiver_set_lock(app->tpms_receiver, app->lock);
 
     //Load history to receiver
-    tpms_view_receiver_exit(app->tpms_receiver);
-    for(uint8_t i = 0; i < tpms_history_get_item(app->txrx->history); i++) {
-        furi_string_reset(str_buff);
-        tpms_history_get_text_item_menu(app->txrx->history, str_buff, i);
-        tpms_view_receiver_add_item_to_menu(
-            app->tpms_receiver,
-            furi_string_get_cstr(str_buff),
-            tpms_history_get_type_protocol(app->txrx->history, i));
-        app->txrx->rx_key_state = TPMSRxKeyStateAddKey;
-    }
-    furi_string_free(str_buff);
+    tpms_scene_receiver_load_history(app);
     tpms_scene_receiver_update_statusbar(app);
+    tpms_scene_receiver_shown_frequency = app->txrx->preset->frequency;
 
     tpms_view_receiver_set_callback(app->tpms_receiver, tpms_scene_receiver_callback, app);
     subghz_receiver_set_rx_callback(
         app->txrx->receiver, tpms_scene_receiver_add_to_history_callback, app);
+    subghz_receiver_set_rx_callback(
+        app->txrx->receiver_second, tpms_scene_receiver_add_to_history_callback, app);
 
     if(app->txrx->txrx_state == TPMSTxRxStateRx) {
         tpms_rx_end(app);
     };
-    if((app->txrx->txrx_state == TPMSTxRxStateIDLE) ||
-       (app->txrx->txrx_state == TPMSTxRxStateSleep)) {
+    // While the radio thread is still probing, stay on the Scanning...
+    // screen; RX starts from the RadioReady event instead
+    if(app->txrx->radio_ready &&
+       ((app->txrx->txrx_state == TPMSTxRxStateIDLE) ||
+        (app->txrx->txrx_state == TPMSTxRxStateSleep))) {
         tpms_begin(
             app,
-            subghz_setting_get_preset_data_by_name(
+            tpms_setting_get_preset_data_by_name(
                 app->setting, furi_string_get_cstr(app->txrx->preset->name)));
 
         tpms_rx(app, app->txrx->preset->frequency);
@@ -160,18 +268,44 @@ bool tpms_scene_receiver_on_event(void* context, SceneManagerEvent event) {
     if(event.type == SceneManagerEventTypeCustom) {
         switch(event.event) {
         case TPMSCustomEventViewReceiverBack:
+            // The history must outlive the export walking it; a session
+            // this size finishes in well under a second, wait it out
+            if(tpms_export_get_state(app->export) == TPMSExportStateRunning) {
+                tpms_export_cancel(app->export);
+                tpms_export_finish(app->export);
+                tpms_view_receiver_set_export_progress(app->tpms_receiver, false, 0, 0);
+            }
+            // The monitor released charge suppression for its sleep
+            // window; leaving the scene sleeps the radio anyway, so just
+            // rebalance and drop the pending wake
+            if(app->txrx->monitor_sleeping) {
+                furi_hal_power_suppress_charge_enter();
+                app->txrx->monitor_sleeping = false;
+            }
+            // Stop hopping before the radio goes down so a late hop
+            // cannot retune a radio the scene is putting to sleep
+            tpms_hopper_set_state(app, TPMSHopperStateOFF);
+            // Leaving the scene keys the LF coil off too
+            if(tpms_relearn_worker_is_running(app->relearn_worker)) {
+                tpms_relearn_worker_stop(app->relearn_worker);
+            }
+            tpms_scene_receiver_capture_until = 0;
+            if(tpms_scene_receiver_relearn_blink) {
+                notification_message(app->notifications, &sequence_blink_stop);
+                tpms_scene_receiver_relearn_blink = false;
+            }
             // Stop CC1101 Rx
             if(app->txrx->txrx_state == TPMSTxRxStateRx) {
                 tpms_rx_end(app);
                 tpms_sleep(app);
             };
-            app->txrx->hopper_state = TPMSHopperStateOFF;
             app->txrx->idx_menu_chosen = 0;
             subghz_receiver_set_rx_callback(app->txrx->receiver, NULL, app);
+            subghz_receiver_set_rx_callback(app->txrx->receiver_second, NULL, app);
 
             app->txrx->rx_key_state = TPMSRxKeyStateIDLE;
             tpms_preset_init(
-                app, "AM650", subghz_setting_get_default_frequency(app->setting), NULL, 0);
+                app, "AM650", tpms_setting_get_default_frequency(app->setting), NULL, 0);
             if(scene_manager_has_previous_scene(app->scene_manager, TPMSSceneStart)) {
                 consumed = scene_manager_search_and_switch_to_previous_scene(
                     app->scene_manager, TPMSSceneStart);
@@ -179,11 +313,28 @@ bool tpms_scene_receiver_on_event(void* context, SceneManagerEvent event) {
                 scene_manager_next_scene(app->scene_manager, TPMSSceneStart);
             }
             break;
+        case TPMSCustomEventRadioReady:
+            if((app->txrx->txrx_state == TPMSTxRxStateIDLE) ||
+               (app->txrx->txrx_state == TPMSTxRxStateSleep)) {
+                tpms_begin(
+                    app,
+                    tpms_setting_get_preset_data_by_name(
+                        app->setting, furi_string_get_cstr(app->txrx->preset->name)));
+                tpms_rx(app, app->txrx->preset->frequency);
+                tpms_scene_receiver_update_statusbar(app);
+            }
+            consumed = true;
+            break;
         case TPMSCustomEventViewReceiverOK:
             app->txrx->idx_menu_chosen = tpms_view_receiver_get_idx_menu(app->tpms_receiver);
             scene_manager_next_scene(app->scene_manager, TPMSSceneReceiverInfo);
             consumed = true;
             break;
+        case TPMSCustomEventViewReceiverOKLong:
+            app->txrx->idx_menu_chosen = tpms_view_receiver_get_idx_menu(app->tpms_receiver);
+            scene_manager_next_scene(app->scene_manager, TPMSSceneSensorName);
+            consumed = true;
+            break;
         case TPMSCustomEventViewReceiverConfig:
             app->txrx->idx_menu_chosen = tpms_view_receiver_get_idx_menu(app->tpms_receiver);
             scene_manager_next_scene(app->scene_manager, TPMSSceneReceiverConfig);
@@ -197,14 +348,69 @@ bool tpms_scene_receiver_on_event(void* context, SceneManagerEvent event) {
             app->lock = TPMSLockOff;
             consumed = true;
             break;
+        case TPMSCustomEventSceneRelearnCapture:
+            // The burst did its job, stop keying the coil in rapid mode
+            if(tpms_relearn_worker_is_running(app->relearn_worker)) {
+                tpms_relearn_worker_stop(app->relearn_worker);
+            }
+            if(tpms_scene_receiver_relearn_blink) {
+                notification_message(app->notifications, &sequence_blink_stop);
+                tpms_scene_receiver_relearn_blink = false;
+            }
+            notification_message(app->notifications, &sequence_success);
+            scene_manager_next_scene(app->scene_manager, TPMSSceneReceiverInfo);
+            consumed = true;
+            break;
+        case TPMSCustomEventViewReceiverRelearn:
+            tpms_scene_receiver_relearn_toggle(app, false);
+            consumed = true;
+            break;
+        case TPMSCustomEventViewReceiverRelearnRapid:
+            tpms_scene_receiver_relearn_toggle(app, true);
+            consumed = true;
+            break;
+        case TPMSCustomEventViewReceiverSave:
+            if(tpms_export_start(app->export, app->txrx->history)) {
+                tpms_view_receiver_set_export_progress(
+                    app->tpms_receiver, true, 0, tpms_history_get_item(app->txrx->history));
+                notification_message(app->notifications, &sequence_blink_start_magenta);
+            }
+            consumed = true;
+            break;
         default:
             break;
         }
     } else if(event.type == SceneManagerEventTypeTick) {
-        if(app->txrx->hopper_state != TPMSHopperStateOFF) {
-            tpms_hopper_update(app);
+        // The hopper retunes from its own thread; the tick only mirrors
+        // the frequency it landed on into the status bar
+        if(app->txrx->hopper_state != TPMSHopperStateOFF &&
+           app->txrx->preset->frequency != tpms_scene_receiver_shown_frequency) {
+            tpms_scene_receiver_shown_frequency = app->txrx->preset->frequency;
             tpms_scene_receiver_update_statusbar(app);
         }
+        tpms_monitor_update(app);
+        // A one-shot burst ends on its own thread; mirror that into the
+        // LED the same way export progress is mirrored
+        if(tpms_scene_receiver_relearn_blink &&
+           !tpms_relearn_worker_is_running(app->relearn_worker)) {
+            notification_message(app->notifications, &sequence_blink_stop);
+            tpms_scene_receiver_relearn_blink = false;
+        }
+        // Export runs on its worker; the tick only mirrors its progress
+        // into the status bar and picks up the result
+        TPMSExportState export_state = tpms_export_get_state(app->export);
+        if(export_state == TPMSExportStateRunning) {
+            uint16_t done, total;
+            tpms_export_get_progress(app->export, &done, &total);
+            tpms_view_receiver_set_export_progress(app->tpms_receiver, true, done, total);
+        } else if(export_state == TPMSExportStateDone || export_state == TPMSExportStateError) {
+            tpms_export_finish(app->export);
+            tpms_view_receiver_set_export_progress(app->tpms_receiver, false, 0, 0);
+            notification_message(app->notifications, &sequence_blink_stop);
+            notification_message(
+                app->notifications,
+                (export_state == TPMSExportStateDone) ? &sequence_success : &sequence_error);
+        }
         // Get current RSSI
         float rssi = furi_hal_subghz_get_rssi();
         tpms_view_receiver_set_rssi(app->tpms_receiver, rssi);
@@ -4,6 +4,15 @@ enum TPMSSettingIndex {
     TPMSSettingIndexFrequency,
     TPMSSettingIndexHopping,
     TPMSSettingIndexModulation,
+    TPMSSettingIndexMemFull,
+    TPMSSettingIndexDualRx,
+    TPMSSettingIndexSquelch,
+    TPMSSettingIndexLog,
+    TPMSSettingIndexStream,
+    TPMSSettingIndexRawCapture,
+    TPMSSettingIndexAlertFloor,
+    TPMSSettingIndexAlertDrop,
+    TPMSSettingIndexMonitor,
     TPMSSettingIndexLock,
 };
 
@@ -17,16 +26,90 @@ const uint32_t hopping_value[HOPPING_COUNT] = {
     TPMSHopperStateRunnig,
 };
 
+#define MEM_FULL_COUNT 2
+const char* const mem_full_text[MEM_FULL_COUNT] = {
+    "Stop",
+    "Rewrite",
+};
+
+#define DUAL_RX_COUNT 2
+const char* const dual_rx_text[DUAL_RX_COUNT] = {
+    "OFF",
+    "ON",
+};
+
+#define SQUELCH_COUNT 6
+const char* const squelch_text[SQUELCH_COUNT] = {
+    "OFF",
+    "-90",
+    "-85",
+    "-80",
+    "-75",
+    "-70",
+};
+const float squelch_value[SQUELCH_COUNT] = {
+    0.0f,
+    -90.0f,
+    -85.0f,
+    -80.0f,
+    -75.0f,
+    -70.0f,
+};
+
+#define LOG_COUNT 2
+const char* const log_text[LOG_COUNT] = {
+    "OFF",
+    "ON",
+};
+
+#define STREAM_COUNT 2
+const char* const stream_text[STREAM_COUNT] = {
+    "OFF",
+    "ON",
+};
+
+#define RAW_CAPTURE_COUNT 2
+const char* const raw_capture_text[RAW_CAPTURE_COUNT] = {
+    "OFF",
+    "ON",
+};
+
+#define ALERT_FLOOR_COUNT 6
+const char* const alert_floor_text[ALERT_FLOOR_COUNT] = {
+    "OFF",
+    "1.6",
+    "1.8",
+    "2.0",
+    "2.2",
+    "2.5",
+};
+const int16_t alert_floor_value[ALERT_FLOOR_COUNT] = {0, 160, 180, 200, 220, 250};
+
+#define ALERT_DROP_COUNT 4
+const char* const alert_drop_text[ALERT_DROP_COUNT] = {
+    "OFF",
+    "0.2",
+    "0.3",
+    "0.5",
+};
+const int16_t alert_drop_value[ALERT_DROP_COUNT] = {0, 20, 30, 50};
+
+#define MONITOR_COUNT 2
+const char* const monitor_text[MONITOR_COUNT] = {
+    "OFF",
+    "ON",
+};
+
 uint8_t tpms_scene_receiver_config_next_frequency(const uint32_t value, void* context) {
     furi_assert(context);
     TPMSApp* app = context;
     uint8_t index = 0;
-    for(uint8_t i = 0; i < subghz_setting_get_frequency_count(app->setting); i++) {
-        if(value == subghz_setting_get_frequency(app->setting, i)) {
+    for(uint8_t i = 0; i < tpms_setting_get_frequency_count(app->setting); i++) {
+        if(value == tpms_setting_get_frequency(app->setting, i)) {
             index = i;
             break;
         } else {
-            index = subghz_setting_get_frequency_default_index(app->setting);
+            index = tpms_setting_get_frequency_default_index(app->setting);
         }
     }
     return index;
@@ -36,8 +119,8 @@ uint8_t tpms_scene_receiver_config_next_preset(const char* preset_name, void* co
     furi_assert(context);
     TPMSApp* app = context;
     uint8_t index = 0;
-    for(uint8_t i = 0; i < subghz_setting_get_preset_count(app->setting); i++) {
-        if(!strcmp(subghz_setting_get_preset_name(app->setting, i), preset_name)) {
+    for(uint8_t i = 0; i < tpms_setting_get_preset_count(app->setting); i++) {
+        if(!strcmp(tpms_setting_get_preset_name(app->setting, i), preset_name)) {
             index = i;
             break;
         } else {
@@ -77,13 +160,13 @@ static void tpms_scene_receiver_config_set_frequency(VariableItem* item) {
             text_buf,
             sizeof(text_buf),
             "%lu.%02lu",
-            subghz_setting_get_frequency(app->setting, index) / 1000000,
-            (subghz_setting_get_frequency(app->setting, index) % 1000000) / 10000);
+            tpms_setting_get_frequency(app->setting, index) / 1000000,
+            (tpms_setting_get_frequency(app->setting, index) % 1000000) / 10000);
         variable_item_set_current_value_text(item, text_buf);
-        app->txrx->preset->frequency = subghz_setting_get_frequency(app->setting, index);
+        app->txrx->preset->frequency = tpms_setting_get_frequency(app->setting, index);
     } else {
         variable_item_set_current_value_index(
-            item, subghz_setting_get_frequency_default_index(app->setting));
+            item, tpms_setting_get_frequency_default_index(app->setting));
     }
 }
 
@@ -91,13 +174,13 @@ static void tpms_scene_receiver_config_set_preset(VariableItem* item) {
     TPMSApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
     variable_item_set_current_value_text(
-        item, subghz_setting_get_preset_name(app->setting, index));
+        item, tpms_setting_get_preset_name(app->setting, index));
     tpms_preset_init(
         app,
-        subghz_setting_get_preset_name(app->setting, index),
+        tpms_setting_get_preset_name(app->setting, index),
         app->txrx->preset->frequency,
-        subghz_setting_get_preset_data(app->setting, index),
-        subghz_setting_get_preset_data_size(app->setting, index));
+        tpms_setting_get_preset_data(app->setting, index),
+        tpms_setting_get_preset_data_size(app->setting, index));
 }
 
 static void tpms_scene_receiver_config_set_hopping_running(VariableItem* item) {
@@ -111,17 +194,17 @@ static void tpms_scene_receiver_config_set_hopping_running(VariableItem* item) {
             text_buf,
             sizeof(text_buf),
             "%lu.%02lu",
-            subghz_setting_get_default_frequency(app->setting) / 1000000,
-            (subghz_setting_get_default_frequency(app->setting) % 1000000) / 10000);
+            tpms_setting_get_default_frequency(app->setting) / 1000000,
+            (tpms_setting_get_default_frequency(app->setting) % 1000000) / 10000);
         variable_item_set_current_value_text(
             (VariableItem*)scene_manager_get_scene_state(
                 app->scene_manager, TPMSSceneReceiverConfig),
             text_buf);
-        app->txrx->preset->frequency = subghz_setting_get_default_frequency(app->setting);
+        app->txrx->preset->frequency = tpms_setting_get_default_frequency(app->setting);
         variable_item_set_current_value_index(
             (VariableItem*)scene_manager_get_scene_state(
                 app->scene_manager, TPMSSceneReceiverConfig),
-            subghz_setting_get_frequency_default_index(app->setting));
+            tpms_setting_get_frequency_default_index(app->setting));
     } else {
         variable_item_set_current_value_text(
             (VariableItem*)scene_manager_get_scene_state(
@@ -130,10 +213,89 @@ static void tpms_scene_receiver_config_set_hopping_running(VariableItem* item) {
         variable_item_set_current_value_index(
             (VariableItem*)scene_manager_get_scene_state(
                 app->scene_manager, TPMSSceneReceiverConfig),
-            subghz_setting_get_frequency_default_index(app->setting));
+            tpms_setting_get_frequency_default_index(app->setting));
     }
 
-    app->txrx->hopper_state = hopping_value[index];
+    tpms_hopper_set_state(app, hopping_value[index]);
+}
+
+static void tpms_scene_receiver_config_set_mem_full(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, mem_full_text[index]);
+    tpms_history_set_overwrite(app->txrx->history, index == 1);
+}
+
+static void tpms_scene_receiver_config_set_dual_rx(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    // The second band needs the internal radio free, i.e. an external one
+    // carrying the primary stream
+    if(index == 1 && !tpms_dual_rx_available(app)) {
+        index = 0;
+        variable_item_set_current_value_index(item, index);
+    }
+    variable_item_set_current_value_text(item, dual_rx_text[index]);
+    app->txrx->dual_rx = (index == 1);
+}
+
+static void tpms_scene_receiver_config_set_squelch(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, squelch_text[index]);
+    app->txrx->squelch_index = index;
+    tpms_edge_batcher_set_squelch(app->txrx->batcher, index != 0, squelch_value[index]);
+}
+
+static void tpms_scene_receiver_config_set_log(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, log_text[index]);
+    tpms_session_log_set_enabled(app->session_log, index == 1);
+}
+
+static void tpms_scene_receiver_config_set_stream(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, stream_text[index]);
+    tpms_stream_set_enabled(app->stream, index == 1);
+}
+
+static void tpms_scene_receiver_config_set_raw_capture(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, raw_capture_text[index]);
+    tpms_raw_capture_set_enabled(app->raw_capture, index == 1);
+}
+
+static void tpms_scene_receiver_config_set_alert_floor(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, alert_floor_text[index]);
+    tpms_alert_set_pressure_floor(app->alert, alert_floor_value[index]);
+}
+
+static void tpms_scene_receiver_config_set_alert_drop(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, alert_drop_text[index]);
+    tpms_alert_set_delta_drop(app->alert, alert_drop_value[index]);
+}
+
+static void tpms_scene_receiver_config_set_monitor(VariableItem* item) {
+    TPMSApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, monitor_text[index]);
+    tpms_monitor_set_enabled(app, index == 1);
 }
 
 static void tpms_scene_receiver_config_var_list_enter_callback(void* context, uint32_t index) {
@@ -152,7 +314,7 @@ void tpms_scene_receiver_config_on_enter(void* context) {
     item = variable_item_list_add(
         app->variable_item_list,
         "Frequency:",
-        subghz_setting_get_frequency_count(app->setting),
+        tpms_setting_get_frequency_count(app->setting),
         tpms_scene_receiver_config_set_frequency,
         app);
     value_index = tpms_scene_receiver_config_next_frequency(app->txrx->preset->frequency, app);
@@ -163,8 +325,8 @@ void tpms_scene_receiver_config_on_enter(void* context) {
         text_buf,
         sizeof(text_buf),
         "%lu.%02lu",
-        subghz_setting_get_frequency(app->setting, value_index) / 1000000,
-        (subghz_setting_get_frequency(app->setting, value_index) % 1000000) / 10000);
+        tpms_setting_get_frequency(app->setting, value_index) / 1000000,
+        (tpms_setting_get_frequency(app->setting, value_index) % 1000000) / 10000);
     variable_item_set_current_value_text(item, text_buf);
 
     item = variable_item_list_add(
@@ -181,14 +343,106 @@ void tpms_scene_receiver_config_on_enter(void* context) {
     item = variable_item_list_add(
         app->variable_item_list,
         "Modulation:",
-        subghz_setting_get_preset_count(app->setting),
+        tpms_setting_get_preset_count(app->setting),
         tpms_scene_receiver_config_set_preset,
         app);
     value_index =
         tpms_scene_receiver_config_next_preset(furi_string_get_cstr(app->txrx->preset->name), app);
     variable_item_set_current_value_index(item, value_index);
     variable_item_set_current_value_text(
-        item, subghz_setting_get_preset_name(app->setting, value_index));
+        item, tpms_setting_get_preset_name(app->setting, value_index));
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Mem full:",
+        MEM_FULL_COUNT,
+        tpms_scene_receiver_config_set_mem_full,
+        app);
+    value_index = tpms_history_get_overwrite(app->txrx->history) ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, mem_full_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Dual band:",
+        DUAL_RX_COUNT,
+        tpms_scene_receiver_config_set_dual_rx,
+        app);
+    value_index = app->txrx->dual_rx ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, dual_rx_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Squelch:",
+        SQUELCH_COUNT,
+        tpms_scene_receiver_config_set_squelch,
+        app);
+    value_index = app->txrx->squelch_index;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, squelch_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list, "Log to SD:", LOG_COUNT, tpms_scene_receiver_config_set_log, app);
+    value_index = tpms_session_log_get_enabled(app->session_log) ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, log_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Stream:",
+        STREAM_COUNT,
+        tpms_scene_receiver_config_set_stream,
+        app);
+    value_index = tpms_stream_get_enabled(app->stream) ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, stream_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "RAW rec.:",
+        RAW_CAPTURE_COUNT,
+        tpms_scene_receiver_config_set_raw_capture,
+        app);
+    value_index = tpms_raw_capture_get_enabled(app->raw_capture) ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, raw_capture_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "P floor:",
+        ALERT_FLOOR_COUNT,
+        tpms_scene_receiver_config_set_alert_floor,
+        app);
+    value_index = 0;
+    for(uint8_t i = 0; i < ALERT_FLOOR_COUNT; i++) {
+        if(alert_floor_value[i] == tpms_alert_get_pressure_floor(app->alert)) value_index = i;
+    }
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, alert_floor_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "P drop:",
+        ALERT_DROP_COUNT,
+        tpms_scene_receiver_config_set_alert_drop,
+        app);
+    value_index = 0;
+    for(uint8_t i = 0; i < ALERT_DROP_COUNT; i++) {
+        if(alert_drop_value[i] == tpms_alert_get_delta_drop(app->alert)) value_index = i;
+    }
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, alert_drop_text[value_index]);
+
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Monitor:",
+        MONITOR_COUNT,
+        tpms_scene_receiver_config_set_monitor,
+        app);
+    value_index = app->txrx->monitor_enabled ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, monitor_text[value_index]);
 
     variable_item_list_add(app->variable_item_list, "Lock Keyboard", 1, NULL, NULL);
     variable_item_list_set_enter_callback(
@@ -1,6 +1,13 @@
 #include "../tpms_app_i.h"
 #include "../views/tpms_receiver.h"
 
+static void tpms_scene_receiver_info_update_trend(TPMSApp* app) {
+    TPMSTrendSample trend[TPMS_HISTORY_TREND_DEPTH];
+    uint8_t count = tpms_history_get_trend(
+        app->txrx->history, app->txrx->idx_menu_chosen, trend, TPMS_HISTORY_TREND_DEPTH);
+    tpms_view_receiver_info_set_trend(app->tpms_receiver_info, trend, count);
+}
+
 void tpms_scene_receiver_info_callback(TPMSCustomEvent event, void* context) {
     furi_assert(context);
     TPMSApp* app = context;
@@ -16,9 +23,10 @@ static void tpms_scene_receiver_info_add_to_history_callback(
 
     if(tpms_history_add_to_history(app->txrx->history, decoder_base, app->txrx->preset) ==
        TPMSHistoryStateAddKeyUpdateData) {
-        tpms_view_receiver_info_update(
+        tpms_view_receiver_info_set_record(
             app->tpms_receiver_info,
-            tpms_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen));
+            tpms_history_get_record(app->txrx->history, app->txrx->idx_menu_chosen));
+        tpms_scene_receiver_info_update_trend(app);
         subghz_receiver_reset(receiver);
 
         notification_message(app->notifications, &sequence_blink_green_10);
@@ -31,9 +39,10 @@ void tpms_scene_receiver_info_on_enter(void* context) {
 
     subghz_receiver_set_rx_callback(
         app->txrx->receiver, tpms_scene_receiver_info_add_to_history_callback, app);
-    tpms_view_receiver_info_update(
+    tpms_view_receiver_info_set_record(
         app->tpms_receiver_info,
-        tpms_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen));
+        tpms_history_get_record(app->txrx->history, app->txrx->idx_menu_chosen));
+    tpms_scene_receiver_info_update_trend(app);
     view_dispatcher_switch_to_view(app->view_dispatcher, TPMSViewReceiverInfo);
 }
 
@@ -13,15 +13,14 @@ const char* const relearn_setting_text[TPMSRelearnSettingNum] = {
     "ON",
 };
 
-enum TPMSRelearnType {
-    TPMSRelearnCommon, // Just signal without data
-    // TPMSRelearnGM_FORD,
-    // TPMSRelearnAnotherOEM,
-    TPMSRelearnTypeNum,
-};
+// Value indexes match TPMSRelearnType
+#define TPMS_RELEARN_TYPE_NUM 4
 
-const char* const relearn_type_text[TPMSRelearnTypeNum] = {
-    "Common",
+const char* const relearn_type_text[TPMS_RELEARN_TYPE_NUM] = {
+    "Common", // Just carrier without data
+    "Schrader",
+    "GM/Ford",
+    "Toyo/Nis/Hyu",
 };
 
 static void tpms_scene_relearn_setting_callback(VariableItem* item) {
@@ -38,12 +37,7 @@ static void tpms_scene_relearn_setting_callback(VariableItem* item) {
 static void tpms_scene_relearn_type_callback(VariableItem* item) {
     TPMSApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
-    if(index == TPMSRelearnCommon) {
-        app->relearn_type = TPMSRelearnTypeCommon;
-    } else {
-        FURI_LOG_E(TAG, "Relearn type %d not implemented", index);
-        return;
-    }
+    app->relearn_type = index;
     variable_item_set_current_value_text(item, relearn_type_text[index]);
 }
 
@@ -63,7 +57,7 @@ void tpms_scene_relearn_config_on_enter(void* context) {
     variable_item_set_current_value_text(item, relearn_setting_text[app->relearn]);
 
     item = variable_item_list_add(
-        var_item_list, "Type", TPMSRelearnTypeNum, tpms_scene_relearn_type_callback, app);
+        var_item_list, "Type", TPMS_RELEARN_TYPE_NUM, tpms_scene_relearn_type_callback, app);
     variable_item_set_current_value_index(item, app->relearn_type);
     variable_item_set_current_value_text(item, relearn_type_text[app->relearn_type]);
 
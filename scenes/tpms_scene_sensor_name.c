@@ -0,0 +1,56 @@
+#include "../tpms_app_i.h"
+
+static void tpms_scene_sensor_name_text_input_callback(void* context) {
+    TPMSApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, TPMSCustomEventSceneSensorName);
+}
+
+void tpms_scene_sensor_name_on_enter(void* context) {
+    TPMSApp* app = context;
+
+    const TPMSHistoryRecord* record =
+        tpms_history_get_record(app->txrx->history, app->txrx->idx_menu_chosen);
+
+    // Prefill with the current label so renaming is an edit, not a retype
+    const char* label = tpms_sensor_db_get_label(app->sensor_db, record->id);
+    if(label) {
+        strlcpy(app->text_store, label, sizeof(app->text_store));
+    } else {
+        app->text_store[0] = '\0';
+    }
+
+    text_input_set_header_text(app->text_input, "Name sensor");
+    text_input_set_result_callback(
+        app->text_input,
+        tpms_scene_sensor_name_text_input_callback,
+        app,
+        app->text_store,
+        TPMS_SENSOR_DB_LABEL_LEN,
+        true);
+
+    view_dispatcher_switch_to_view(app->view_dispatcher, TPMSViewTextInput);
+}
+
+bool tpms_scene_sensor_name_on_event(void* context, SceneManagerEvent event) {
+    TPMSApp* app = context;
+    bool consumed = false;
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == TPMSCustomEventSceneSensorName) {
+            const TPMSHistoryRecord* record =
+                tpms_history_get_record(app->txrx->history, app->txrx->idx_menu_chosen);
+            if(!tpms_sensor_db_set_label(app->sensor_db, record->id, app->text_store)) {
+                FURI_LOG_W("TPMSSceneSensorName", "Sensor database full");
+            }
+            tpms_sensor_db_save(app->sensor_db);
+            tpms_history_refresh_item_menu(app->txrx->history, app->txrx->idx_menu_chosen);
+            scene_manager_previous_scene(app->scene_manager);
+            consumed = true;
+        }
+    }
+    return consumed;
+}
+
+void tpms_scene_sensor_name_on_exit(void* context) {
+    TPMSApp* app = context;
+    text_input_reset(app->text_input);
+}
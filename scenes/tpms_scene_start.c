@@ -2,8 +2,12 @@
 
 typedef enum {
     SubmenuIndexTPMSReceiver,
+    SubmenuIndexTPMSPresetDetect,
     SubmenuIndexTPMSConfigGuide,
     SubmenuIndexTPMSRelearn,
+    SubmenuIndexTPMSSweep,
+    SubmenuIndexTPMSStats,
+    SubmenuIndexTPMSBenchmark,
     SubmenuIndexTPMSAbout,
 } SubmenuIndex;
 
@@ -19,10 +23,22 @@ void tpms_scene_start_on_enter(void* context) {
 
     submenu_add_item(
         submenu, "Read TPMS", SubmenuIndexTPMSReceiver, tpms_scene_start_submenu_callback, app);
+    submenu_add_item(
+        submenu,
+        "Auto Detect",
+        SubmenuIndexTPMSPresetDetect,
+        tpms_scene_start_submenu_callback,
+        app);
     submenu_add_item(
         submenu, "Config Guide", SubmenuIndexTPMSConfigGuide, tpms_scene_start_submenu_callback, app);
     submenu_add_item(
         submenu, "Relearn", SubmenuIndexTPMSRelearn, tpms_scene_start_submenu_callback, app);
+    submenu_add_item(
+        submenu, "Spectrum", SubmenuIndexTPMSSweep, tpms_scene_start_submenu_callback, app);
+    submenu_add_item(
+        submenu, "Decoder Stats", SubmenuIndexTPMSStats, tpms_scene_start_submenu_callback, app);
+    submenu_add_item(
+        submenu, "Benchmark", SubmenuIndexTPMSBenchmark, tpms_scene_start_submenu_callback, app);
     // Help
     submenu_add_item(
         submenu, "About", SubmenuIndexTPMSAbout, tpms_scene_start_submenu_callback, app);
@@ -49,12 +65,24 @@ bool tpms_scene_start_on_event(void* context, SceneManagerEvent event) {
         } else if(event.event == SubmenuIndexTPMSReceiver) {
             scene_manager_next_scene(app->scene_manager, TPMSSceneReceiver);
             consumed = true;
+        } else if(event.event == SubmenuIndexTPMSPresetDetect) {
+            scene_manager_next_scene(app->scene_manager, TPMSScenePresetDetect);
+            consumed = true;
         } else if(event.event == SubmenuIndexTPMSConfigGuide) {
             scene_manager_next_scene(app->scene_manager, TPMSSceneConfigGuide);
             consumed = true;
         } else if(event.event == SubmenuIndexTPMSRelearn) {
             scene_manager_next_scene(app->scene_manager, TPMSSceneRelearn);
             consumed = true;
+        } else if(event.event == SubmenuIndexTPMSSweep) {
+            scene_manager_next_scene(app->scene_manager, TPMSSceneSweep);
+            consumed = true;
+        } else if(event.event == SubmenuIndexTPMSStats) {
+            scene_manager_next_scene(app->scene_manager, TPMSSceneStats);
+            consumed = true;
+        } else if(event.event == SubmenuIndexTPMSBenchmark) {
+            scene_manager_next_scene(app->scene_manager, TPMSSceneBenchmark);
+            consumed = true;
         }
         scene_manager_set_scene_state(app->scene_manager, TPMSSceneStart, event.event);
     }
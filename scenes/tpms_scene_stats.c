@@ -0,0 +1,95 @@
+#include "../tpms_app_i.h"
+#include "../protocols/protocol_items.h"
+#include "../protocols/tpms_decoder_stats.h"
+
+// Widget rebuilds reset the scroll position, so refresh once a second
+// instead of on every 100ms dispatcher tick
+#define TPMS_SCENE_STATS_REFRESH_TICKS 10
+
+static void tpms_scene_stats_widget_callback(GuiButtonType result, InputType type, void* context) {
+    TPMSApp* app = context;
+    if(type == InputTypeShort) {
+        view_dispatcher_send_custom_event(app->view_dispatcher, result);
+    }
+}
+
+static void tpms_scene_stats_update(TPMSApp* app) {
+    widget_reset(app->widget);
+
+    widget_add_text_box_element(
+        app->widget,
+        0,
+        2,
+        128,
+        14,
+        AlignCenter,
+        AlignBottom,
+        "\e#\e!         Decoder Stats        \e!\n",
+        false);
+
+    FuriString* temp_str;
+    temp_str = furi_string_alloc();
+
+    for(size_t i = 0; i < subghz_protocol_registry_count(&tpms_protocol_registry); ++i) {
+        const SubGhzProtocol* protocol =
+            subghz_protocol_registry_get_by_index(&tpms_protocol_registry, i);
+        furi_string_cat_printf(
+            temp_str,
+            "\e#%s\n"
+            "Edges: %lu Syncs: %lu\n"
+            "Frames: %lu CRC err: %lu\n"
+            "Aborts: %lu\n",
+            protocol->name,
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatEdges),
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatSyncs),
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatFrames),
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatCrcErrors),
+            tpms_decoder_stats_get(tpms_protocol_stats_slot(i), TPMSDecoderStatAborts));
+    }
+    furi_string_cat_printf(
+        temp_str, "\e#%s\nLost edges: %lu\n", "Stream", tpms_edge_batcher_get_lost(app->txrx->batcher));
+
+    widget_add_text_scroll_element(app->widget, 0, 16, 128, 38, furi_string_get_cstr(temp_str));
+    furi_string_free(temp_str);
+
+    widget_add_button_element(
+        app->widget, GuiButtonTypeCenter, "Reset", tpms_scene_stats_widget_callback, app);
+}
+
+void tpms_scene_stats_on_enter(void* context) {
+    TPMSApp* app = context;
+
+    tpms_scene_stats_update(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, TPMSViewWidget);
+}
+
+bool tpms_scene_stats_on_event(void* context, SceneManagerEvent event) {
+    TPMSApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == GuiButtonTypeCenter) {
+            tpms_decoder_stats_reset();
+            tpms_scene_stats_update(app);
+            consumed = true;
+        }
+    } else if(event.type == SceneManagerEventTypeTick) {
+        uint32_t ticks = scene_manager_get_scene_state(app->scene_manager, TPMSSceneStats) + 1;
+        if(ticks >= TPMS_SCENE_STATS_REFRESH_TICKS) {
+            tpms_scene_stats_update(app);
+            ticks = 0;
+        }
+        scene_manager_set_scene_state(app->scene_manager, TPMSSceneStats, ticks);
+        consumed = true;
+    }
+
+    return consumed;
+}
+
+void tpms_scene_stats_on_exit(void* context) {
+    TPMSApp* app = context;
+
+    // Clear views
+    widget_reset(app->widget);
+    scene_manager_set_scene_state(app->scene_manager, TPMSSceneStats, 0);
+}
@@ -0,0 +1,188 @@
+#include "../tpms_app_i.h"
+#include "../views/tpms_sweep.h"
+
+#define TAG "TPMSSceneSweep"
+
+// Fine scan windows around the two TPMS bands, on top of the hopper table
+#define TPMS_SWEEP_FINE_STEP_HZ 100000
+#define TPMS_SWEEP_FINE_STEPS 5
+
+// See RSSI Calculation timings in CC1101 17.3 RSSI: the filtered RSSI
+// needs a couple of milliseconds in RX before the register is meaningful
+#define TPMS_SWEEP_DWELL_MS 3
+
+// Bins visited per dispatcher tick; 8 x (retune + dwell) stays well under
+// the tick period, and a ~30 bin table completes a pass in under half a
+// second
+#define TPMS_SWEEP_STEPS_PER_TICK 8
+
+// Bar scaling: -90dBm sits on the baseline, -30dBm tops out the plot
+#define TPMS_SWEEP_RSSI_FLOOR (-90.0f)
+#define TPMS_SWEEP_RSSI_CEIL (-30.0f)
+#define TPMS_SWEEP_BAR_MAX 48
+
+typedef struct {
+    uint32_t frequencies[TPMS_SWEEP_MAX_POINTS];
+    uint8_t levels[TPMS_SWEEP_MAX_POINTS];
+    uint16_t count;
+    uint16_t idx;
+    uint32_t peak_frequency;
+    float peak_rssi;
+    bool radio_started;
+} TPMSSweepState;
+
+static TPMSSweepState* tpms_sweep_state;
+
+static void tpms_scene_sweep_add_frequency(TPMSApp* app, uint32_t frequency) {
+    TPMSSweepState* state = tpms_sweep_state;
+    if(state->count >= TPMS_SWEEP_MAX_POINTS) return;
+    if(!subghz_devices_is_frequency_valid(app->txrx->radio_device, frequency)) return;
+    // Bins closer than half a fine step would sample the same channel
+    for(uint16_t i = 0; i < state->count; i++) {
+        uint32_t diff = (state->frequencies[i] > frequency) ?
+                            state->frequencies[i] - frequency :
+                            frequency - state->frequencies[i];
+        if(diff < TPMS_SWEEP_FINE_STEP_HZ / 2) return;
+    }
+    state->frequencies[state->count++] = frequency;
+}
+
+static void tpms_scene_sweep_build_table(TPMSApp* app) {
+    TPMSSweepState* state = tpms_sweep_state;
+
+    for(uint8_t i = 0; i < tpms_setting_get_hopper_frequency_count(app->setting); i++) {
+        tpms_scene_sweep_add_frequency(app, tpms_setting_get_hopper_frequency(app->setting, i));
+    }
+    const uint32_t centers[] = {315000000, 433920000};
+    for(size_t c = 0; c < COUNT_OF(centers); c++) {
+        for(int8_t step = -TPMS_SWEEP_FINE_STEPS; step <= TPMS_SWEEP_FINE_STEPS; step++) {
+            tpms_scene_sweep_add_frequency(
+                app, centers[c] + (int32_t)step * TPMS_SWEEP_FINE_STEP_HZ);
+        }
+    }
+
+    // Ascending order so the plot reads as a spectrum
+    for(uint16_t i = 1; i < state->count; i++) {
+        uint32_t frequency = state->frequencies[i];
+        uint16_t j = i;
+        while(j && state->frequencies[j - 1] > frequency) {
+            state->frequencies[j] = state->frequencies[j - 1];
+            j--;
+        }
+        state->frequencies[j] = frequency;
+    }
+}
+
+static void tpms_scene_sweep_step(TPMSApp* app) {
+    TPMSSweepState* state = tpms_sweep_state;
+    const SubGhzDevice* device = app->txrx->radio_device;
+
+    // Hopping is off here, but a hop already in flight when the scene
+    // entered may still hold the radio; the mutex orders us behind it
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
+    for(uint8_t n = 0; n < TPMS_SWEEP_STEPS_PER_TICK; n++) {
+        uint32_t frequency = state->frequencies[state->idx];
+        subghz_devices_idle(device);
+        subghz_devices_set_frequency(device, frequency);
+        subghz_devices_set_rx(device);
+        furi_delay_ms(TPMS_SWEEP_DWELL_MS);
+        float rssi = subghz_devices_get_rssi(device);
+
+        float span = rssi - TPMS_SWEEP_RSSI_FLOOR;
+        if(span < 0) span = 0;
+        uint8_t level =
+            (uint8_t)(span * TPMS_SWEEP_BAR_MAX / (TPMS_SWEEP_RSSI_CEIL - TPMS_SWEEP_RSSI_FLOOR));
+        state->levels[state->idx] = MIN(level, (uint8_t)TPMS_SWEEP_BAR_MAX);
+
+        if(!state->peak_frequency || rssi > state->peak_rssi) {
+            state->peak_rssi = rssi;
+            state->peak_frequency = frequency;
+        }
+
+        state->idx = (state->idx + 1) % state->count;
+    }
+    furi_mutex_release(app->txrx->radio_mutex);
+
+    tpms_view_sweep_set_levels(
+        app->tpms_sweep,
+        state->levels,
+        state->count,
+        state->idx,
+        state->peak_frequency,
+        state->peak_rssi);
+}
+
+static void tpms_scene_sweep_callback(TPMSCustomEvent event, void* context) {
+    furi_assert(context);
+    TPMSApp* app = context;
+    view_dispatcher_send_custom_event(app->view_dispatcher, event);
+}
+
+void tpms_scene_sweep_on_enter(void* context) {
+    TPMSApp* app = context;
+
+    tpms_sweep_state = malloc(sizeof(TPMSSweepState));
+
+    tpms_hopper_set_state(app, TPMSHopperStateOFF);
+    if(app->txrx->txrx_state == TPMSTxRxStateRx) {
+        tpms_rx_end(app);
+    }
+
+    tpms_view_sweep_set_callback(app->tpms_sweep, tpms_scene_sweep_callback, app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, TPMSViewSweep);
+}
+
+bool tpms_scene_sweep_on_event(void* context, SceneManagerEvent event) {
+    TPMSApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        switch(event.event) {
+        case TPMSCustomEventViewSweepBack:
+            scene_manager_previous_scene(app->scene_manager);
+            consumed = true;
+            break;
+        case TPMSCustomEventViewSweepResetPeaks:
+            tpms_sweep_state->peak_frequency = 0;
+            tpms_sweep_state->peak_rssi = 0;
+            consumed = true;
+            break;
+        case TPMSCustomEventRadioReady:
+            consumed = true;
+            break;
+        default:
+            break;
+        }
+    } else if(event.type == SceneManagerEventTypeTick) {
+        // Wait out the radio probe thread, then claim the radio once
+        if(app->txrx->radio_ready) {
+            // The validity filter asks the probed device, so the table
+            // can only be built once the probe has produced one
+            if(!tpms_sweep_state->count) {
+                tpms_scene_sweep_build_table(app);
+            }
+            if(tpms_sweep_state->count) {
+                if(!tpms_sweep_state->radio_started) {
+                    tpms_begin(
+                        app,
+                        tpms_setting_get_preset_data_by_name(
+                            app->setting, furi_string_get_cstr(app->txrx->preset->name)));
+                    tpms_sweep_state->radio_started = true;
+                }
+                tpms_scene_sweep_step(app);
+            }
+        }
+    }
+    return consumed;
+}
+
+void tpms_scene_sweep_on_exit(void* context) {
+    TPMSApp* app = context;
+
+    if(tpms_sweep_state->radio_started) {
+        subghz_devices_idle(app->txrx->radio_device);
+        tpms_sleep(app);
+    }
+    free(tpms_sweep_state);
+    tpms_sweep_state = NULL;
+}
@@ -3,6 +3,7 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include "protocols/protocol_items.h"
+#include "protocols/tpms_timing_cal.h"
 
 static bool tpms_app_custom_event_callback(void* context, uint32_t event) {
     furi_assert(context);
@@ -22,6 +23,30 @@ static void tpms_app_tick_event_callback(void* context) {
     scene_manager_handle_tick_event(app->scene_manager);
 }
 
+// Radio detection and bring-up, overlapped with view construction. The
+// external CC1101 probe busy-waits through OTG power-up and settling, pure
+// dead time the GUI does not have to pay for. The receiver scene starts RX
+// on the RadioReady event or, if it enters later, straight from on_enter
+static int32_t tpms_app_radio_init_thread(void* context) {
+    furi_assert(context);
+    TPMSApp* app = context;
+
+    subghz_devices_init();
+
+    app->txrx->radio_device =
+        radio_device_loader_set(NULL, SubGhzRadioDeviceTypeExternalCC1101);
+
+    subghz_devices_reset(app->txrx->radio_device);
+    subghz_devices_idle(app->txrx->radio_device);
+
+    tpms_edge_batcher_set_squelch_device(app->txrx->batcher, 0, app->txrx->radio_device);
+    tpms_raw_capture_set_device(app->raw_capture, app->txrx->radio_device);
+
+    app->txrx->radio_ready = true;
+    view_dispatcher_send_custom_event(app->view_dispatcher, TPMSCustomEventRadioReady);
+    return 0;
+}
+
 TPMSApp* tpms_app_alloc() {
     TPMSApp* app = malloc(sizeof(TPMSApp));
 
@@ -42,6 +67,58 @@ TPMSApp* tpms_app_alloc() {
 
     view_dispatcher_attach_to_gui(app->view_dispatcher, app->gui, ViewDispatcherTypeFullscreen);
 
+    //init Worker & Protocol, the RAM-only part the radio thread depends on
+    app->lock = TPMSLockOff;
+    app->txrx = malloc(sizeof(TPMSTxRx));
+    app->txrx->radio_device = NULL;
+    app->txrx->radio_ready = false;
+    app->txrx->radio_mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
+    app->txrx->worker = subghz_worker_alloc();
+    app->txrx->environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(
+        app->txrx->environment, (void*)&tpms_protocol_registry);
+    app->txrx->receiver = subghz_receiver_alloc_init(app->txrx->environment);
+
+    // Second radio path for dual-band RX, idle until enabled in config
+    app->txrx->receiver_second = subghz_receiver_alloc_init(app->txrx->environment);
+    app->txrx->worker_second = subghz_worker_alloc();
+    app->txrx->preset_second = malloc(sizeof(SubGhzRadioPreset));
+    app->txrx->preset_second->name = furi_string_alloc_set("AM650");
+    app->txrx->preset_second->frequency = 0;
+    app->txrx->preset_second->data = NULL;
+    app->txrx->preset_second->data_size = 0;
+    app->txrx->radio_device_second = NULL;
+    app->txrx->dual_rx = false;
+
+    subghz_receiver_set_filter(app->txrx->receiver, SubGhzProtocolFlag_Decodable);
+    tpms_protocol_front_end_init();
+    tpms_timing_cal_load();
+    app->txrx->batcher = tpms_edge_batcher_alloc(app->txrx->receiver);
+    tpms_edge_batcher_set_source_receiver(app->txrx->batcher, 1, app->txrx->receiver_second);
+    app->txrx->squelch_index = 0;
+
+    // RAW edge capture tees off the primary radio's worker stream; the
+    // trigger radio is attached once the radio thread has probed it
+    app->raw_capture = tpms_raw_capture_alloc(NULL);
+    tpms_edge_batcher_set_tee(
+        app->txrx->batcher, 0, tpms_raw_capture_feed, app->raw_capture);
+    subghz_worker_set_overrun_callback(
+        app->txrx->worker, (SubGhzWorkerOverrunCallback)tpms_edge_batcher_overrun_callback);
+    subghz_worker_set_pair_callback(
+        app->txrx->worker, (SubGhzWorkerPairCallback)tpms_edge_batcher_pair_callback);
+    subghz_worker_set_context(app->txrx->worker, tpms_edge_batcher_get_source(app->txrx->batcher, 0));
+    subghz_worker_set_overrun_callback(
+        app->txrx->worker_second, (SubGhzWorkerOverrunCallback)tpms_edge_batcher_overrun_callback);
+    subghz_worker_set_pair_callback(
+        app->txrx->worker_second, (SubGhzWorkerPairCallback)tpms_edge_batcher_pair_callback);
+    subghz_worker_set_context(
+        app->txrx->worker_second, tpms_edge_batcher_get_source(app->txrx->batcher, 1));
+
+    // Radio probe runs while the views below are constructed
+    app->radio_init_thread =
+        furi_thread_alloc_ex("TPMSRadioInit", 1024, tpms_app_radio_init_thread, app);
+    furi_thread_start(app->radio_init_thread);
+
     // Open Notification record
     app->notifications = furi_record_open(RECORD_NOTIFICATION);
 
@@ -61,6 +138,11 @@ TPMSApp* tpms_app_alloc() {
     app->widget = widget_alloc();
     view_dispatcher_add_view(app->view_dispatcher, TPMSViewWidget, widget_get_view(app->widget));
 
+    // Text Input
+    app->text_input = text_input_alloc();
+    view_dispatcher_add_view(
+        app->view_dispatcher, TPMSViewTextInput, text_input_get_view(app->text_input));
+
     // Receiver
     app->tpms_receiver = tpms_view_receiver_alloc();
     view_dispatcher_add_view(
@@ -73,41 +155,42 @@ TPMSApp* tpms_app_alloc() {
         TPMSViewReceiverInfo,
         tpms_view_receiver_info_get_view(app->tpms_receiver_info));
 
-    //init setting
-    app->setting = subghz_setting_alloc();
+    // Spectrum sweep
+    app->tpms_sweep = tpms_view_sweep_alloc();
+    view_dispatcher_add_view(
+        app->view_dispatcher, TPMSViewSweep, tpms_view_sweep_get_view(app->tpms_sweep));
+
+    //init setting, binary-cache accelerated
+    app->setting = tpms_setting_alloc();
 
     //ToDo FIX  file name setting
-    subghz_setting_load(app->setting, EXT_PATH("subghz/assets/setting_user"));
+    tpms_setting_load(app->setting, EXT_PATH("subghz/assets/setting_user"));
 
-    //init Worker & Protocol & History
-    app->lock = TPMSLockOff;
-    app->txrx = malloc(sizeof(TPMSTxRx));
+    //init preset & History
     app->txrx->preset = malloc(sizeof(SubGhzRadioPreset));
     app->txrx->preset->name = furi_string_alloc();
-    tpms_preset_init(app, "AM650", subghz_setting_get_default_frequency(app->setting), NULL, 0);
+    tpms_preset_init(app, "AM650", tpms_setting_get_default_frequency(app->setting), NULL, 0);
+
+    app->session_log = tpms_session_log_alloc();
+    app->stream = tpms_stream_alloc();
+    app->export = tpms_export_alloc();
+    app->alert = tpms_alert_alloc();
+    app->sensor_db = tpms_sensor_db_alloc();
+    app->relearn_worker = tpms_relearn_worker_alloc();
 
     app->txrx->hopper_state = TPMSHopperStateOFF;
+    app->txrx->hopper_idx_frequency = 0;
+    app->txrx->hopper_hop_count = 0;
+    memset(app->txrx->hopper_hits, 0, sizeof(app->txrx->hopper_hits));
+    // Sleeps until hopping is enabled from the receiver config
+    tpms_hopper_thread_start(app);
+    app->txrx->monitor_enabled = false;
+    app->txrx->monitor_sleeping = false;
+    app->txrx->monitor_wake_at = 0;
+    memset(app->txrx->monitor_slots, 0, sizeof(app->txrx->monitor_slots));
     app->txrx->history = tpms_history_alloc();
-    app->txrx->worker = subghz_worker_alloc();
-    app->txrx->environment = subghz_environment_alloc();
-    subghz_environment_set_protocol_registry(
-        app->txrx->environment, (void*)&tpms_protocol_registry);
-    app->txrx->receiver = subghz_receiver_alloc_init(app->txrx->environment);
-
-    subghz_devices_init();
-
-    app->txrx->radio_device =
-        radio_device_loader_set(NULL, SubGhzRadioDeviceTypeExternalCC1101);
-
-    subghz_devices_reset(app->txrx->radio_device);
-    subghz_devices_idle(app->txrx->radio_device);
-
-    subghz_receiver_set_filter(app->txrx->receiver, SubGhzProtocolFlag_Decodable);
-    subghz_worker_set_overrun_callback(
-        app->txrx->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-    subghz_worker_set_pair_callback(
-        app->txrx->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
-    subghz_worker_set_context(app->txrx->worker, app->txrx->receiver);
+    tpms_history_set_label_resolver(
+        app->txrx->history, (TPMSHistoryLabelResolver)tpms_sensor_db_get_label, app->sensor_db);
 
     furi_hal_power_suppress_charge_enter();
 
@@ -119,6 +202,13 @@ TPMSApp* tpms_app_alloc() {
 void tpms_app_free(TPMSApp* app) {
     furi_assert(app);
 
+    // If the user backed out before the probe finished, wait it out
+    furi_thread_join(app->radio_init_thread);
+    furi_thread_free(app->radio_init_thread);
+
+    // Hopper next: it is the only other thread touching the radio
+    tpms_hopper_thread_stop(app);
+
     subghz_devices_sleep(app->txrx->radio_device);
     radio_device_loader_end(app->txrx->radio_device);
 
@@ -136,6 +226,10 @@ void tpms_app_free(TPMSApp* app) {
     view_dispatcher_remove_view(app->view_dispatcher, TPMSViewWidget);
     widget_free(app->widget);
 
+    // Text Input
+    view_dispatcher_remove_view(app->view_dispatcher, TPMSViewTextInput);
+    text_input_free(app->text_input);
+
     // Receiver
     view_dispatcher_remove_view(app->view_dispatcher, TPMSViewReceiver);
     tpms_view_receiver_free(app->tpms_receiver);
@@ -144,16 +238,46 @@ void tpms_app_free(TPMSApp* app) {
     view_dispatcher_remove_view(app->view_dispatcher, TPMSViewReceiverInfo);
     tpms_view_receiver_info_free(app->tpms_receiver_info);
 
+    // Spectrum sweep
+    view_dispatcher_remove_view(app->view_dispatcher, TPMSViewSweep);
+    tpms_view_sweep_free(app->tpms_sweep);
+
     //setting
-    subghz_setting_free(app->setting);
+    tpms_setting_free(app->setting);
+
+    //Session log, flushes pending records
+    tpms_session_log_free(app->session_log);
+
+    //Stream, flushes pending events and releases the serial port
+    tpms_stream_free(app->stream);
+
+    //Export, joins the worker if a save is still in flight
+    tpms_export_free(app->export);
+
+    tpms_alert_free(app->alert);
+    tpms_sensor_db_free(app->sensor_db);
+
+    //Relearn, stops any burst still keying the coil
+    tpms_relearn_worker_free(app->relearn_worker);
+    tpms_timing_cal_save();
+
+    //RAW capture, detach the tee before its buffers go away
+    tpms_edge_batcher_set_tee(app->txrx->batcher, 0, NULL, NULL);
+    tpms_raw_capture_free(app->raw_capture);
 
     //Worker & Protocol & History
+    tpms_edge_batcher_free(app->txrx->batcher);
     subghz_receiver_free(app->txrx->receiver);
+    subghz_receiver_free(app->txrx->receiver_second);
     subghz_environment_free(app->txrx->environment);
     tpms_history_free(app->txrx->history);
     subghz_worker_free(app->txrx->worker);
+    subghz_worker_free(app->txrx->worker_second);
     furi_string_free(app->txrx->preset->name);
     free(app->txrx->preset);
+    furi_string_free(app->txrx->preset_second->name);
+    free(app->txrx->preset_second);
+    furi_mutex_free(app->txrx->radio_mutex);
     free(app->txrx);
 
     // View dispatcher
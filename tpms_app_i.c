@@ -2,6 +2,7 @@
 
 #define TAG "TPMS"
 #include <flipper_format/flipper_format_i.h>
+#include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 
 void tpms_preset_init(
     void* context,
@@ -51,6 +52,7 @@ void tpms_get_frequency_modulation(TPMSApp* app, FuriString* frequency, FuriStri
 
 void tpms_begin(TPMSApp* app, uint8_t* preset_data) {
     furi_assert(app);
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
     subghz_devices_reset(app->txrx->radio_device);
     subghz_devices_idle(app->txrx->radio_device);
     if(preset_data) {
@@ -59,6 +61,72 @@ void tpms_begin(TPMSApp* app, uint8_t* preset_data) {
         subghz_devices_load_preset(app->txrx->radio_device, FuriHalSubGhzPresetOok650Async, NULL);
     }
     app->txrx->txrx_state = TPMSTxRxStateIDLE;
+    furi_mutex_release(app->txrx->radio_mutex);
+}
+
+void tpms_update_receiver_filter(TPMSApp* app) {
+    furi_assert(app);
+    SubGhzProtocolFlag filter = SubGhzProtocolFlag_Decodable;
+
+    // Modulation of the active preset
+    const char* preset_name = furi_string_get_cstr(app->txrx->preset->name);
+    if(!strncmp(preset_name, "AM", 2)) {
+        filter |= SubGhzProtocolFlag_AM;
+    } else if(!strncmp(preset_name, "FM", 2)) {
+        filter |= SubGhzProtocolFlag_FM;
+    }
+
+    // Frequency band we are parked on
+    uint32_t frequency = app->txrx->preset->frequency;
+    if(frequency < 400000000) {
+        filter |= SubGhzProtocolFlag_315;
+    } else if(frequency < 600000000) {
+        filter |= SubGhzProtocolFlag_433;
+    }
+
+    // Receiver feeds only decoders declaring every filter bit, so
+    // protocols dead on this preset cost zero cycles
+    subghz_receiver_set_filter(app->txrx->receiver, filter);
+}
+
+bool tpms_dual_rx_available(TPMSApp* app) {
+    furi_assert(app);
+    // The internal CC1101 is only free for the second band when the
+    // external one carries the primary stream
+    return radio_device_loader_is_external(app->txrx->radio_device);
+}
+
+static void tpms_dual_rx_start(TPMSApp* app, uint32_t primary_frequency) {
+    if(subghz_worker_is_running(app->txrx->worker_second)) return;
+
+    const SubGhzDevice* device = subghz_devices_get_by_name(SUBGHZ_DEVICE_CC1101_INT_NAME);
+    // Park the internal radio on the band the primary is not covering
+    uint32_t frequency = (primary_frequency < 400000000) ? 433920000 : 315000000;
+    if(!subghz_devices_is_frequency_valid(device, frequency)) return;
+
+    furi_string_set(app->txrx->preset_second->name, "AM650");
+    app->txrx->preset_second->frequency = frequency;
+
+    SubGhzProtocolFlag filter = SubGhzProtocolFlag_Decodable | SubGhzProtocolFlag_AM;
+    filter |= (frequency < 400000000) ? SubGhzProtocolFlag_315 : SubGhzProtocolFlag_433;
+    subghz_receiver_set_filter(app->txrx->receiver_second, filter);
+
+    app->txrx->radio_device_second = device;
+    tpms_edge_batcher_set_squelch_device(app->txrx->batcher, 1, device);
+    subghz_devices_reset(device);
+    subghz_devices_idle(device);
+    subghz_devices_load_preset(device, FuriHalSubGhzPresetOok650Async, NULL);
+    subghz_devices_set_frequency(device, frequency);
+    subghz_devices_flush_rx(device);
+    subghz_devices_start_async_rx(device, subghz_worker_rx_callback, app->txrx->worker_second);
+    subghz_worker_start(app->txrx->worker_second);
+}
+
+static void tpms_dual_rx_stop(TPMSApp* app) {
+    if(!subghz_worker_is_running(app->txrx->worker_second)) return;
+    subghz_worker_stop(app->txrx->worker_second);
+    subghz_devices_stop_async_rx(app->txrx->radio_device_second);
+    subghz_devices_idle(app->txrx->radio_device_second);
 }
 
 uint32_t tpms_rx(TPMSApp* app, uint32_t frequency) {
@@ -66,87 +134,303 @@ uint32_t tpms_rx(TPMSApp* app, uint32_t frequency) {
     if(!subghz_devices_is_frequency_valid(app->txrx->radio_device, frequency)) {
         furi_crash("TPMS: Incorrect RX frequency.");
     }
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
     furi_assert(
         app->txrx->txrx_state != TPMSTxRxStateRx && app->txrx->txrx_state != TPMSTxRxStateSleep);
 
+    tpms_update_receiver_filter(app);
     subghz_devices_idle(app->txrx->radio_device);
     uint32_t value = subghz_devices_set_frequency(app->txrx->radio_device, frequency);
     subghz_devices_flush_rx(app->txrx->radio_device);
     subghz_devices_start_async_rx(app->txrx->radio_device, subghz_worker_rx_callback, app->txrx->worker);
     subghz_worker_start(app->txrx->worker);
+    if(app->txrx->dual_rx && tpms_dual_rx_available(app)) {
+        tpms_dual_rx_start(app, frequency);
+    }
+    tpms_raw_capture_set_active(app->raw_capture, true, frequency);
     app->txrx->txrx_state = TPMSTxRxStateRx;
+    furi_mutex_release(app->txrx->radio_mutex);
     return value;
 }
 
 void tpms_idle(TPMSApp* app) {
     furi_assert(app);
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
     furi_assert(app->txrx->txrx_state != TPMSTxRxStateSleep);
     subghz_devices_idle(app->txrx->radio_device);
     app->txrx->txrx_state = TPMSTxRxStateIDLE;
+    furi_mutex_release(app->txrx->radio_mutex);
 }
 
 void tpms_rx_end(TPMSApp* app) {
     furi_assert(app);
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
     furi_assert(app->txrx->txrx_state == TPMSTxRxStateRx);
+    tpms_raw_capture_set_active(app->raw_capture, false, 0);
+    tpms_dual_rx_stop(app);
     if(subghz_worker_is_running(app->txrx->worker)) {
         subghz_worker_stop(app->txrx->worker);
         subghz_devices_stop_async_rx(app->txrx->radio_device);
     }
     subghz_devices_idle(app->txrx->radio_device);
     app->txrx->txrx_state = TPMSTxRxStateIDLE;
+    furi_mutex_release(app->txrx->radio_mutex);
 }
 
 void tpms_sleep(TPMSApp* app) {
     furi_assert(app);
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
     subghz_devices_sleep(app->txrx->radio_device);
     app->txrx->txrx_state = TPMSTxRxStateSleep;
+    furi_mutex_release(app->txrx->radio_mutex);
 }
 
-void tpms_hopper_update(TPMSApp* app) {
+// Frequency hopper. Hopping used to ride the 100 ms GUI tick, which tied
+// the dwell on each frequency to rendering load; it now runs on its own
+// thread with millisecond deadlines, and the receiver scene merely
+// observes the frequency changing under it.
+//
+// All times in milliseconds: base time parked per hop, extra parking
+// earned per decoded frame, cap on the learned dwell, listening window
+// after a live carrier and the hop period after which all hit counts are
+// halved
+#define TPMS_HOPPER_HOP_MS 100
+#define TPMS_HOPPER_RSSI_PAUSE_MS 1000
+#define TPMS_HOPPER_DWELL_HITS_PER_STEP 4
+#define TPMS_HOPPER_DWELL_MAX_MS 1000
+#define TPMS_HOPPER_DECAY_HOPS 64
+
+#define TPMS_HOPPER_FLAG_EXIT (1 << 0)
+#define TPMS_HOPPER_FLAG_KICK (1 << 1)
+
+void tpms_hopper_register_hit(TPMSApp* app) {
     furi_assert(app);
+    if(app->txrx->hopper_state == TPMSHopperStateOFF) return;
+    uint8_t idx = app->txrx->hopper_idx_frequency;
+    if(idx < TPMS_HOPPER_MAX_FREQUENCIES && app->txrx->hopper_hits[idx] < UINT16_MAX) {
+        app->txrx->hopper_hits[idx]++;
+    }
+}
 
-    switch(app->txrx->hopper_state) {
-    case TPMSHopperStateOFF:
-    case TPMSHopperStatePause:
-        return;
-    case TPMSHopperStateRSSITimeOut:
-        if(app->txrx->hopper_timeout != 0) {
-            app->txrx->hopper_timeout--;
-            return;
-        }
-        break;
-    default:
-        break;
+void tpms_hopper_set_state(TPMSApp* app, TPMSHopperState state) {
+    furi_assert(app);
+    app->txrx->hopper_state = state;
+    // Wake the hopper thread so the change takes effect now, not on its
+    // next scheduled hop
+    if(app->hopper_thread) {
+        furi_thread_flags_set(furi_thread_get_id(app->hopper_thread), TPMS_HOPPER_FLAG_KICK);
+    }
+}
+
+// One hop decision; returns how long the thread sleeps before the next
+// one, FuriWaitForever while hopping is off. Runs off the GUI thread, so
+// every radio touch stays inside the radio mutex
+static uint32_t tpms_hopper_step(TPMSApp* app) {
+    if(app->txrx->hopper_state == TPMSHopperStateOFF ||
+       app->txrx->hopper_state == TPMSHopperStatePause) {
+        return FuriWaitForever;
+    }
+    // Radio still probing: check back shortly
+    if(!app->txrx->radio_ready) return TPMS_HOPPER_HOP_MS;
+
+    furi_mutex_acquire(app->txrx->radio_mutex, FuriWaitForever);
+    // Re-check under the lock, a scene may have stopped hopping or taken
+    // the radio down while we waited for it
+    if(app->txrx->hopper_state == TPMSHopperStateOFF ||
+       app->txrx->hopper_state == TPMSHopperStatePause ||
+       app->txrx->txrx_state != TPMSTxRxStateRx) {
+        bool off = app->txrx->hopper_state != TPMSHopperStateRunnig &&
+                   app->txrx->hopper_state != TPMSHopperStateRSSITimeOut;
+        furi_mutex_release(app->txrx->radio_mutex);
+        return off ? FuriWaitForever : TPMS_HOPPER_HOP_MS;
     }
-    float rssi = -127.0f;
-    if(app->txrx->hopper_state != TPMSHopperStateRSSITimeOut) {
+
+    if(app->txrx->hopper_state == TPMSHopperStateRSSITimeOut) {
+        // The carrier got its listening window, resume hopping
+        app->txrx->hopper_state = TPMSHopperStateRunnig;
+    } else {
         // See RSSI Calculation timings in CC1101 17.3 RSSI
-        rssi = subghz_devices_get_rssi(app->txrx->radio_device);
+        float rssi = subghz_devices_get_rssi(app->txrx->radio_device);
 
         // Stay if RSSI is high enough
         if(rssi > -90.0f) {
-            app->txrx->hopper_timeout = 10;
+            tpms_hopper_register_hit(app);
             app->txrx->hopper_state = TPMSHopperStateRSSITimeOut;
-            return;
+            furi_mutex_release(app->txrx->radio_mutex);
+            return TPMS_HOPPER_RSSI_PAUSE_MS;
         }
-    } else {
-        app->txrx->hopper_state = TPMSHopperStateRunnig;
     }
     // Select next frequency
     if(app->txrx->hopper_idx_frequency <
-       subghz_setting_get_hopper_frequency_count(app->setting) - 1) {
+       tpms_setting_get_hopper_frequency_count(app->setting) - 1) {
         app->txrx->hopper_idx_frequency++;
     } else {
         app->txrx->hopper_idx_frequency = 0;
     }
 
-    if(app->txrx->txrx_state == TPMSTxRxStateRx) {
-        tpms_rx_end(app);
-    };
-    if(app->txrx->txrx_state == TPMSTxRxStateIDLE) {
-        subghz_receiver_reset(app->txrx->receiver);
-        app->txrx->preset->frequency =
-            subghz_setting_get_hopper_frequency(app->setting, app->txrx->hopper_idx_frequency);
+    // Learned dwell for the new frequency: park longer where traffic has
+    // been decoding, the retune below is the expensive part of the hop.
+    // Periodic decay ages out stale hot spots and keeps the quiet
+    // frequencies explored
+    uint32_t dwell_ms = 0;
+    if(app->txrx->hopper_idx_frequency < TPMS_HOPPER_MAX_FREQUENCIES) {
+        dwell_ms = (uint32_t)(app->txrx->hopper_hits[app->txrx->hopper_idx_frequency] /
+                              TPMS_HOPPER_DWELL_HITS_PER_STEP) *
+                   TPMS_HOPPER_HOP_MS;
+        if(dwell_ms > TPMS_HOPPER_DWELL_MAX_MS) dwell_ms = TPMS_HOPPER_DWELL_MAX_MS;
+    }
+    if(++app->txrx->hopper_hop_count >= TPMS_HOPPER_DECAY_HOPS) {
+        app->txrx->hopper_hop_count = 0;
+        for(size_t i = 0; i < TPMS_HOPPER_MAX_FREQUENCIES; i++) {
+            app->txrx->hopper_hits[i] >>= 1;
+        }
+    }
+
+    tpms_rx_end(app);
+    subghz_receiver_reset(app->txrx->receiver);
+    app->txrx->preset->frequency =
+        tpms_setting_get_hopper_frequency(app->setting, app->txrx->hopper_idx_frequency);
+    tpms_rx(app, app->txrx->preset->frequency);
+    furi_mutex_release(app->txrx->radio_mutex);
+    return TPMS_HOPPER_HOP_MS + dwell_ms;
+}
+
+static int32_t tpms_hopper_thread(void* context) {
+    furi_assert(context);
+    TPMSApp* app = context;
+
+    uint32_t timeout = FuriWaitForever;
+    for(;;) {
+        uint32_t flags = furi_thread_flags_wait(
+            TPMS_HOPPER_FLAG_EXIT | TPMS_HOPPER_FLAG_KICK, FuriFlagWaitAny, timeout);
+        if(!(flags & FuriFlagError) && (flags & TPMS_HOPPER_FLAG_EXIT)) break;
+        uint32_t next_ms = tpms_hopper_step(app);
+        timeout = (next_ms == FuriWaitForever) ? FuriWaitForever : furi_ms_to_ticks(next_ms);
+    }
+    return 0;
+}
+
+void tpms_hopper_thread_start(TPMSApp* app) {
+    furi_assert(app);
+    app->hopper_thread = furi_thread_alloc_ex("TPMSHopper", 1024, tpms_hopper_thread, app);
+    furi_thread_start(app->hopper_thread);
+}
+
+void tpms_hopper_thread_stop(TPMSApp* app) {
+    furi_assert(app);
+    furi_thread_flags_set(furi_thread_get_id(app->hopper_thread), TPMS_HOPPER_FLAG_EXIT);
+    furi_thread_join(app->hopper_thread);
+    furi_thread_free(app->hopper_thread);
+    app->hopper_thread = NULL;
+}
+
+// Duty-cycle monitor: TPMS sensors transmit on a fixed period (typically
+// 30..60s), so once the period of every tracked sensor is learned the
+// radio can sleep between the expected windows. Wake this many seconds
+// early, count a frame as on-schedule this long after its window, and
+// only bother sleeping when the gap is worth the retune.
+#define TPMS_MONITOR_PERIOD_MIN 10
+#define TPMS_MONITOR_PERIOD_MAX 120
+#define TPMS_MONITOR_GUARD_PRE 3
+#define TPMS_MONITOR_GUARD_POST 5
+#define TPMS_MONITOR_SLEEP_MIN 5
+
+static void tpms_monitor_wake(TPMSApp* app) {
+    // Charge suppression was released for the sleep window, re-enter it
+    // for the RX phase like the rest of the app does
+    furi_hal_power_suppress_charge_enter();
+    if(app->txrx->txrx_state == TPMSTxRxStateSleep) {
+        tpms_begin(
+            app,
+            tpms_setting_get_preset_data_by_name(
+                app->setting, furi_string_get_cstr(app->txrx->preset->name)));
         tpms_rx(app, app->txrx->preset->frequency);
     }
+    app->txrx->monitor_sleeping = false;
+}
+
+void tpms_monitor_note_frame(TPMSApp* app, uint32_t id, uint32_t timestamp) {
+    furi_assert(app);
+    TPMSMonitorSlot* slot = NULL;
+    TPMSMonitorSlot* oldest = &app->txrx->monitor_slots[0];
+    for(size_t i = 0; i < TPMS_MONITOR_MAX_SENSORS; i++) {
+        TPMSMonitorSlot* cur = &app->txrx->monitor_slots[i];
+        if(cur->seen && cur->id == id) {
+            slot = cur;
+            break;
+        }
+        if(!cur->seen || cur->last_seen < oldest->last_seen) oldest = cur;
+    }
+    if(!slot) {
+        // Recycle the stalest slot, a sensor gone quiet is likely parked
+        // out of range anyway
+        slot = oldest;
+        slot->id = id;
+        slot->period = 0;
+        slot->seen = 0;
+    }
+    if(slot->seen && timestamp > slot->last_seen) {
+        uint32_t delta = timestamp - slot->last_seen;
+        // Burst retransmits (delta below the floor) and gaps from missed
+        // frames (above the ceiling) would both corrupt the estimate
+        if(delta >= TPMS_MONITOR_PERIOD_MIN && delta <= TPMS_MONITOR_PERIOD_MAX) {
+            slot->period = slot->period ? (slot->period * 3 + delta) / 4 : delta;
+        }
+    }
+    slot->last_seen = timestamp;
+    if(slot->seen < UINT8_MAX) slot->seen++;
+}
+
+void tpms_monitor_update(TPMSApp* app) {
+    furi_assert(app);
+    uint32_t now = furi_hal_rtc_get_timestamp();
+
+    // The hopper owns the radio schedule when it is running
+    if(!app->txrx->monitor_enabled || app->txrx->hopper_state != TPMSHopperStateOFF) {
+        if(app->txrx->monitor_sleeping) tpms_monitor_wake(app);
+        return;
+    }
+
+    if(app->txrx->monitor_sleeping) {
+        if(now >= app->txrx->monitor_wake_at) tpms_monitor_wake(app);
+        return;
+    }
+
+    if(app->txrx->txrx_state != TPMSTxRxStateRx) return;
+
+    // Earliest expected frame across the tracked set; a sensor without a
+    // learned period keeps the radio awake until it has one
+    uint32_t next = UINT32_MAX;
+    bool any = false;
+    for(size_t i = 0; i < TPMS_MONITOR_MAX_SENSORS; i++) {
+        TPMSMonitorSlot* slot = &app->txrx->monitor_slots[i];
+        if(!slot->seen) continue;
+        if(!slot->period) return;
+        uint32_t expected = slot->last_seen + slot->period;
+        // A missed frame must not stall the schedule, advance to the next
+        // window still ahead of us
+        while(expected + TPMS_MONITOR_GUARD_POST < now) {
+            expected += slot->period;
+        }
+        if(expected < next) next = expected;
+        any = true;
+    }
+    if(!any) return;
+    if(next <= now + TPMS_MONITOR_GUARD_PRE + TPMS_MONITOR_SLEEP_MIN) return;
+
+    tpms_rx_end(app);
+    tpms_sleep(app);
+    // Let the battery charge while the radio is parked
+    furi_hal_power_suppress_charge_exit();
+    app->txrx->monitor_wake_at = next - TPMS_MONITOR_GUARD_PRE;
+    app->txrx->monitor_sleeping = true;
+    FURI_LOG_I(TAG, "Monitor: radio sleeping %lus", app->txrx->monitor_wake_at - now);
+}
+
+void tpms_monitor_set_enabled(TPMSApp* app, bool enabled) {
+    furi_assert(app);
+    app->txrx->monitor_enabled = enabled;
+    // Turned off from the config scene while asleep: no tick will run
+    // until the receiver scene is back, so wake the radio right here
+    if(!enabled && app->txrx->monitor_sleeping) tpms_monitor_wake(app);
 }
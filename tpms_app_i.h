@@ -9,9 +9,11 @@
 #include <gui/modules/submenu.h>
 #include <gui/modules/variable_item_list.h>
 #include <gui/modules/widget.h>
+#include <gui/modules/text_input.h>
 #include <notification/notification_messages.h>
 #include "views/tpms_receiver.h"
 #include "views/tpms_receiver_info.h"
+#include "views/tpms_sweep.h"
 #include "tpms_history.h"
 
 #include <lib/subghz/subghz_setting.h>
@@ -22,22 +24,71 @@
 #include <lib/subghz/devices/devices.h>
 
 #include "helpers/radio_device_loader.h"
+#include "helpers/tpms_setting.h"
+#include "helpers/tpms_edge_batcher.h"
+#include "helpers/tpms_session_log.h"
+#include "helpers/tpms_stream.h"
+#include "helpers/tpms_export.h"
+#include "helpers/tpms_raw_capture.h"
+#include "helpers/tpms_alert.h"
+#include "helpers/tpms_sensor_db.h"
+#include "helpers/tpms_relearn.h"
 
 typedef struct TPMSApp TPMSApp;
 
+// Upper bound on tracked hopper frequencies, covers any sane setting file
+#define TPMS_HOPPER_MAX_FREQUENCIES 32
+
+// Sensors tracked by the duty-cycle monitor, two cars worth of wheels
+#define TPMS_MONITOR_MAX_SENSORS 8
+
+// Learned transmit schedule of one sensor, timestamps in RTC seconds
+typedef struct {
+    uint32_t id;
+    uint32_t last_seen;
+    uint32_t period;
+    uint8_t seen;
+} TPMSMonitorSlot;
+
 struct TPMSTxRx {
     SubGhzWorker* worker;
+    TPMSEdgeBatcher* batcher;
 
     const SubGhzDevice* radio_device;
+    // Set by the radio init thread once detection and reset are done;
+    // until then the receiver scene shows Scanning... without starting RX
+    volatile bool radio_ready;
     SubGhzEnvironment* environment;
     SubGhzReceiver* receiver;
     SubGhzRadioPreset* preset;
+
+    // Second radio for dual-band RX: the internal CC1101 parked on the
+    // band the primary is not covering, with its own worker and receiver
+    const SubGhzDevice* radio_device_second;
+    SubGhzWorker* worker_second;
+    SubGhzReceiver* receiver_second;
+    SubGhzRadioPreset* preset_second;
+    bool dual_rx;
+    uint8_t squelch_index;
+
+    // Serializes radio access between the GUI thread and the hopper
+    // thread; recursive, the hopper retunes through tpms_rx_end/tpms_rx
+    // which take it on their own
+    FuriMutex* radio_mutex;
+
     TPMSHistory* history;
     uint16_t idx_menu_chosen;
     TPMSTxRxState txrx_state;
     TPMSHopperState hopper_state;
-    uint8_t hopper_timeout;
     uint8_t hopper_idx_frequency;
+    uint8_t hopper_hop_count;
+    uint16_t hopper_hits[TPMS_HOPPER_MAX_FREQUENCIES];
+
+    // Duty-cycled RX: sleep the radio between expected sensor windows
+    bool monitor_enabled;
+    bool monitor_sleeping;
+    uint32_t monitor_wake_at;
+    TPMSMonitorSlot monitor_slots[TPMS_MONITOR_MAX_SENSORS];
     TPMSRxKeyState rx_key_state;
 };
 
@@ -52,10 +103,22 @@ struct TPMSApp {
     VariableItemList* variable_item_list;
     Submenu* submenu;
     Widget* widget;
+    TextInput* text_input;
+    char text_store[TPMS_SENSOR_DB_LABEL_LEN];
     TPMSReceiver* tpms_receiver;
     TPMSReceiverInfo* tpms_receiver_info;
+    TPMSSweep* tpms_sweep;
     TPMSLock lock;
-    SubGhzSetting* setting;
+    TPMSSetting* setting;
+    TPMSSessionLog* session_log;
+    TPMSStream* stream;
+    TPMSExport* export;
+    TPMSRawCapture* raw_capture;
+    TPMSAlert* alert;
+    TPMSSensorDB* sensor_db;
+    FuriThread* radio_init_thread;
+    FuriThread* hopper_thread;
+    TPMSRelearnWorker* relearn_worker;
     TPMSRelearn relearn;
     TPMSRelearnType relearn_type;
 };
@@ -67,10 +130,18 @@ void tpms_preset_init(
     uint8_t* preset_data,
     size_t preset_data_size);
 bool tpms_set_preset(TPMSApp* app, const char* preset);
+void tpms_update_receiver_filter(TPMSApp* app);
 void tpms_get_frequency_modulation(TPMSApp* app, FuriString* frequency, FuriString* modulation);
 void tpms_begin(TPMSApp* app, uint8_t* preset_data);
 uint32_t tpms_rx(TPMSApp* app, uint32_t frequency);
+bool tpms_dual_rx_available(TPMSApp* app);
 void tpms_idle(TPMSApp* app);
 void tpms_rx_end(TPMSApp* app);
 void tpms_sleep(TPMSApp* app);
-void tpms_hopper_update(TPMSApp* app);
+void tpms_hopper_thread_start(TPMSApp* app);
+void tpms_hopper_thread_stop(TPMSApp* app);
+void tpms_hopper_set_state(TPMSApp* app, TPMSHopperState state);
+void tpms_hopper_register_hit(TPMSApp* app);
+void tpms_monitor_note_frame(TPMSApp* app, uint32_t id, uint32_t timestamp);
+void tpms_monitor_update(TPMSApp* app);
+void tpms_monitor_set_enabled(TPMSApp* app, bool enabled);
@@ -1,94 +1,166 @@
 #include "tpms_history.h"
-#include <flipper_format/flipper_format_i.h>
-#include <lib/toolbox/stream/stream.h>
 #include <lib/subghz/receiver.h>
 #include "protocols/tpms_generic.h"
+#include "protocols/protocol_items.h"
 
 #include <furi.h>
 
-#define TPMS_HISTORY_MAX 50
+#define TPMS_HISTORY_MAX 200
+// Open-addressing id index, power of two, kept at most half full
+#define TPMS_HISTORY_INDEX_SIZE 512
+#define TPMS_HISTORY_INDEX_MASK (TPMS_HISTORY_INDEX_SIZE - 1)
+#define TPMS_HISTORY_INDEX_FREE 0xFFFF
 #define TAG "TPMSHistory"
 
+// A retransmit burst would flush the trend ring in seconds, so samples
+// are only taken at the base interval or on a real pressure change
+#define TPMS_HISTORY_TREND_MIN_INTERVAL 30 // seconds
+#define TPMS_HISTORY_TREND_MIN_DELTA_CB 5 // centibar
+
+// Retransmits of the same frame land well inside this window
+#define TPMS_HISTORY_DEDUP_WINDOW_MS 500
+
 typedef struct {
     FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    uint32_t id;
-    SubGhzRadioPreset* preset;
+    uint32_t update_tick;
+    // Per-sensor dedup state, probed before the record is touched
+    uint32_t last_hash_tick;
+    uint8_t last_hash;
+    TPMSHistoryRecord record;
+    SubGhzRadioPreset preset;
+    TPMSTrendSample trend[TPMS_HISTORY_TREND_DEPTH];
+    uint8_t trend_head; // next write slot
+    uint8_t trend_count;
 } TPMSHistoryItem;
 
-ARRAY_DEF(TPMSHistoryItemArray, TPMSHistoryItem, M_POD_OPLIST)
-
-#define M_OPL_TPMSHistoryItemArray_t() ARRAY_OPLIST(TPMSHistoryItemArray, M_POD_OPLIST)
-
+/** All item storage comes from this pool, allocated once in
+ *  tpms_history_alloc(). Reset rewinds the write index, steady-state
+ *  operation does no heap traffic at all */
 typedef struct {
-    TPMSHistoryItemArray_t data;
+    TPMSHistoryItem items[TPMS_HISTORY_MAX];
 } TPMSHistoryStruct;
 
+typedef struct {
+    uint32_t id;
+    uint16_t idx;
+} TPMSHistoryIndexSlot;
+
 struct TPMSHistory {
-    uint32_t last_update_timestamp;
     uint16_t last_index_write;
-    uint8_t code_last_hash_data;
-    FuriString* tmp_string;
+    bool overwrite;
+    // Bumped on every change a menu reader could observe; readers compare
+    // it against what they rendered from instead of copying the strings
+    volatile uint32_t generation;
+    // Orders menu-string writes (add, evict-rewrite, label refresh)
+    // against the GUI thread reading them at draw time
+    FuriMutex* mutex;
+    TPMSHistoryLabelResolver label_resolver;
+    void* label_resolver_context;
     TPMSHistoryStruct* history;
+    TPMSHistoryIndexSlot index[TPMS_HISTORY_INDEX_SIZE];
 };
 
+static void tpms_history_index_reset(TPMSHistory* instance) {
+    for(size_t i = 0; i < TPMS_HISTORY_INDEX_SIZE; i++) {
+        instance->index[i].idx = TPMS_HISTORY_INDEX_FREE;
+    }
+}
+
+static uint32_t tpms_history_index_hash(uint32_t id) {
+    // Final avalanche step of MurmurHash3, enough to spread sensor ids
+    id ^= id >> 16;
+    id *= 0x85EBCA6B;
+    id ^= id >> 13;
+    return id;
+}
+
+static void tpms_history_index_insert(TPMSHistory* instance, uint32_t id, uint16_t idx) {
+    uint32_t slot = tpms_history_index_hash(id) & TPMS_HISTORY_INDEX_MASK;
+    while(instance->index[slot].idx != TPMS_HISTORY_INDEX_FREE) {
+        slot = (slot + 1) & TPMS_HISTORY_INDEX_MASK;
+    }
+    instance->index[slot].id = id;
+    instance->index[slot].idx = idx;
+}
+
+static void tpms_history_index_rebuild(TPMSHistory* instance) {
+    tpms_history_index_reset(instance);
+    for(uint16_t i = 0; i < instance->last_index_write; i++) {
+        tpms_history_index_insert(instance, instance->history->items[i].record.id, i);
+    }
+}
+
+bool tpms_history_find_by_id(TPMSHistory* instance, uint32_t id, uint16_t* idx) {
+    furi_assert(instance);
+    uint32_t slot = tpms_history_index_hash(id) & TPMS_HISTORY_INDEX_MASK;
+    while(instance->index[slot].idx != TPMS_HISTORY_INDEX_FREE) {
+        if(instance->index[slot].id == id) {
+            if(idx) *idx = instance->index[slot].idx;
+            return true;
+        }
+        slot = (slot + 1) & TPMS_HISTORY_INDEX_MASK;
+    }
+    return false;
+}
+
 TPMSHistory* tpms_history_alloc(void) {
     TPMSHistory* instance = malloc(sizeof(TPMSHistory));
-    instance->tmp_string = furi_string_alloc();
     instance->history = malloc(sizeof(TPMSHistoryStruct));
-    TPMSHistoryItemArray_init(instance->history->data);
+    for(size_t i = 0; i < TPMS_HISTORY_MAX; i++) {
+        TPMSHistoryItem* item = &instance->history->items[i];
+        item->item_str = furi_string_alloc();
+        item->preset.name = furi_string_alloc();
+    }
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    tpms_history_index_reset(instance);
     return instance;
 }
 
 void tpms_history_free(TPMSHistory* instance) {
     furi_assert(instance);
-    furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, TPMSHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    TPMSHistoryItemArray_clear(instance->history->data);
+    furi_mutex_free(instance->mutex);
+    for(size_t i = 0; i < TPMS_HISTORY_MAX; i++) {
+        TPMSHistoryItem* item = &instance->history->items[i];
+        furi_string_free(item->item_str);
+        furi_string_free(item->preset.name);
+    }
     free(instance->history);
     free(instance);
 }
 
 uint32_t tpms_history_get_frequency(TPMSHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    return instance->history->items[idx].preset.frequency;
 }
 
 SubGhzRadioPreset* tpms_history_get_radio_preset(TPMSHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    return &instance->history->items[idx].preset;
 }
 
 const char* tpms_history_get_preset(TPMSHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    return furi_string_get_cstr(instance->history->items[idx].preset.name);
 }
 
 void tpms_history_reset(TPMSHistory* instance) {
     furi_assert(instance);
-    furi_string_reset(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, TPMSHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    TPMSHistoryItemArray_reset(instance->history->data);
+    // Pool rewind, all item storage stays allocated for reuse
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    tpms_history_index_reset(instance);
     instance->last_index_write = 0;
-    instance->code_last_hash_data = 0;
+    instance->generation++;
+    furi_mutex_release(instance->mutex);
+}
+
+void tpms_history_set_overwrite(TPMSHistory* instance, bool overwrite) {
+    furi_assert(instance);
+    instance->overwrite = overwrite;
+}
+
+bool tpms_history_get_overwrite(TPMSHistory* instance) {
+    furi_assert(instance);
+    return instance->overwrite;
 }
 
 uint16_t tpms_history_get_item(TPMSHistory* instance) {
@@ -96,46 +168,151 @@ uint16_t tpms_history_get_item(TPMSHistory* instance) {
     return instance->last_index_write;
 }
 
+uint32_t tpms_history_get_generation(TPMSHistory* instance) {
+    furi_assert(instance);
+    return instance->generation;
+}
+
 uint8_t tpms_history_get_type_protocol(TPMSHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    return instance->history->items[idx].record.type;
 }
 
 const char* tpms_history_get_protocol_name(TPMSHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
+    return instance->history->items[idx].record.protocol_name;
+}
+
+const TPMSHistoryRecord* tpms_history_get_record(TPMSHistory* instance, uint16_t idx) {
+    furi_assert(instance);
+    return &instance->history->items[idx].record;
+}
+
+void tpms_history_get_record_snapshot(
+    TPMSHistory* instance,
+    uint16_t idx,
+    TPMSHistoryRecord* record,
+    SubGhzRadioPreset* preset) {
+    furi_assert(instance);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    TPMSHistoryItem* item = &instance->history->items[idx];
+    *record = item->record;
+    preset->frequency = item->preset.frequency;
+    furi_string_set(preset->name, item->preset.name);
+    // The custom preset bytes live in the settings and never move, so
+    // copying pointer and size as a consistent pair is enough
+    preset->data = item->preset.data;
+    preset->data_size = item->preset.data_size;
+    furi_mutex_release(instance->mutex);
+}
+
+static void tpms_history_trend_push(TPMSHistoryItem* item, const TPMSHistoryRecord* record) {
+    int16_t pressure_cb = (int16_t)(record->pressure_mb / 10);
+    int16_t temperature_dc = record->temperature_dc;
+
+    if(item->trend_count) {
+        uint8_t last =
+            (item->trend_head + TPMS_HISTORY_TREND_DEPTH - 1) % TPMS_HISTORY_TREND_DEPTH;
+        const TPMSTrendSample* prev = &item->trend[last];
+        if(((record->timestamp - prev->timestamp) < TPMS_HISTORY_TREND_MIN_INTERVAL) &&
+           (abs(pressure_cb - prev->pressure_cb) < TPMS_HISTORY_TREND_MIN_DELTA_CB)) {
+            return;
+        }
     }
-    return furi_string_get_cstr(instance->tmp_string);
+
+    item->trend[item->trend_head] = (TPMSTrendSample){
+        .timestamp = record->timestamp,
+        .pressure_cb = pressure_cb,
+        .temperature_dc = temperature_dc,
+    };
+    item->trend_head = (item->trend_head + 1) % TPMS_HISTORY_TREND_DEPTH;
+    if(item->trend_count < TPMS_HISTORY_TREND_DEPTH) item->trend_count++;
 }
 
-FlipperFormat* tpms_history_get_raw_data(TPMSHistory* instance, uint16_t idx) {
+uint8_t tpms_history_get_trend(
+    TPMSHistory* instance,
+    uint16_t idx,
+    TPMSTrendSample* samples,
+    uint8_t max_count) {
     furi_assert(instance);
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
+    TPMSHistoryItem* item = &instance->history->items[idx];
+    uint8_t count = MIN(item->trend_count, max_count);
+    uint8_t start = (item->trend_count < TPMS_HISTORY_TREND_DEPTH) ?
+                        0 :
+                        item->trend_head; // ring full: head is the oldest
+    for(uint8_t i = 0; i < count; i++) {
+        samples[i] = item->trend[(start + i) % TPMS_HISTORY_TREND_DEPTH];
     }
+    return count;
 }
+
 bool tpms_history_get_text_space_left(TPMSHistory* instance, FuriString* output) {
     furi_assert(instance);
-    if(instance->last_index_write == TPMS_HISTORY_MAX) {
+    if((instance->last_index_write == TPMS_HISTORY_MAX) && !instance->overwrite) {
         if(output != NULL) furi_string_printf(output, "Memory is FULL");
         return true;
     }
     if(output != NULL)
-        furi_string_printf(output, "%02u/%02u", instance->last_index_write, TPMS_HISTORY_MAX);
+        furi_string_printf(output, "%03u/%03u", instance->last_index_write, TPMS_HISTORY_MAX);
     return false;
 }
 
 void tpms_history_get_text_item_menu(TPMSHistory* instance, FuriString* output, uint16_t idx) {
-    TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    furi_string_set(output, instance->history->items[idx].item_str);
+    furi_mutex_release(instance->mutex);
+}
+
+void tpms_history_set_label_resolver(
+    TPMSHistory* instance,
+    TPMSHistoryLabelResolver resolver,
+    void* context) {
+    furi_assert(instance);
+    instance->label_resolver = resolver;
+    instance->label_resolver_context = context;
+}
+
+/** Menu string: the sensor's label when the resolver knows it, otherwise
+ *  protocol name plus raw id */
+static void tpms_history_item_menu_str(TPMSHistory* instance, TPMSHistoryItem* item) {
+    const char* label = NULL;
+    if(instance->label_resolver) {
+        label = instance->label_resolver(instance->label_resolver_context, item->record.id);
+    }
+    if(label) {
+        furi_string_printf(item->item_str, "%s", label);
+    } else {
+        furi_string_printf(
+            item->item_str, "%s %lX", item->record.protocol_name, item->record.id);
+    }
+}
+
+void tpms_history_refresh_item_menu(TPMSHistory* instance, uint16_t idx) {
+    furi_assert(instance);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    tpms_history_item_menu_str(instance, &instance->history->items[idx]);
+    instance->generation++;
+    furi_mutex_release(instance->mutex);
+}
+
+/** Fill the packed record straight from the decoder's generic block,
+ *  zero serialization in the hot path */
+static void tpms_history_read_record(
+    TPMSHistoryRecord* record,
+    SubGhzProtocolDecoderBase* decoder_base,
+    const TPMSBlockGeneric* generic) {
+    record->id = generic->id;
+    record->type = decoder_base->protocol->type;
+    record->battery_low = generic->battery_low;
+    record->data_count_bit = generic->data_count_bit;
+    record->data = generic->data;
+    record->pressure_mb = generic->pressure_mb;
+    record->temperature_dc = generic->temperature_dc;
+    record->protocol_name = decoder_base->protocol->name;
+
+    DateTime curr_dt;
+    furi_hal_rtc_get_datetime(&curr_dt);
+    record->timestamp = datetime_datetime_to_timestamp(&curr_dt);
 }
 
 TPMSHistoryStateAddKey
@@ -143,90 +320,91 @@ TPMSHistoryStateAddKey
     furi_assert(instance);
     furi_assert(context);
 
-    if(instance->last_index_write >= TPMS_HISTORY_MAX) return TPMSHistoryStateAddKeyOverflow;
+    if((instance->last_index_write >= TPMS_HISTORY_MAX) && !instance->overwrite)
+        return TPMSHistoryStateAddKeyOverflow;
 
     SubGhzProtocolDecoderBase* decoder_base = context;
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return TPMSHistoryStateAddKeyTimeOut;
+    const TPMSBlockGeneric* generic = tpms_protocol_get_generic(decoder_base);
+    if(!generic) {
+        FURI_LOG_E(TAG, "Unknown protocol %s", decoder_base->protocol->name);
+        return TPMSHistoryStateAddKeyUnknown;
     }
 
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
-    instance->last_update_timestamp = furi_get_tick();
-
-    FlipperFormat* fff = flipper_format_string_alloc();
-    uint32_t id = 0;
-    subghz_protocol_decoder_base_serialize(decoder_base, fff, preset);
-
-    do {
-        if(!flipper_format_rewind(fff)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_uint32(fff, "Id", (uint32_t*)&id, 1)) {
-            FURI_LOG_E(TAG, "Missing Id");
-            break;
-        }
-    } while(false);
-    flipper_format_free(fff);
-
-    // Update record if found
-    bool sensor_found = false;
-    for(size_t i = 0; i < TPMSHistoryItemArray_size(instance->history->data); i++) {
-        TPMSHistoryItem* item = TPMSHistoryItemArray_get(instance->history->data, i);
-        if(item->id == id) {
-            sensor_found = true;
-            Stream* flipper_string_stream = flipper_format_get_raw_stream(item->flipper_string);
-            stream_clean(flipper_string_stream);
-            subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
-            return TPMSHistoryStateAddKeyUpdateData;
+    // Dedup is keyed per sensor through the id index, so a retransmit of
+    // the frame just stored costs one probe and interleaved traffic from
+    // other sensors never resets the window
+    uint8_t hash = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    uint16_t found_idx;
+    bool found = tpms_history_find_by_id(instance, generic->id, &found_idx);
+    if(found) {
+        TPMSHistoryItem* dedup = &instance->history->items[found_idx];
+        if((dedup->last_hash == hash) &&
+           ((furi_get_tick() - dedup->last_hash_tick) < TPMS_HISTORY_DEDUP_WINDOW_MS)) {
+            dedup->last_hash_tick = furi_get_tick();
+            return TPMSHistoryStateAddKeyTimeOut;
         }
     }
 
-    // or add new record
-    if(!sensor_found) { //-V547
-        TPMSHistoryItem* item = TPMSHistoryItemArray_push_raw(instance->history->data);
-        item->preset = malloc(sizeof(SubGhzRadioPreset));
-        item->type = decoder_base->protocol->type;
-        item->preset->frequency = preset->frequency;
-        item->preset->name = furi_string_alloc();
-        furi_string_set(item->preset->name, preset->name);
-        item->preset->data = preset->data;
-        item->preset->data_size = preset->data_size;
-        item->id = id;
+    TPMSHistoryRecord record = {0};
+    tpms_history_read_record(&record, decoder_base, generic);
 
-        item->item_str = furi_string_alloc();
-        item->flipper_string = flipper_format_string_alloc();
-        subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    // Update record if found
+    if(found) {
+        TPMSHistoryItem* item = &instance->history->items[found_idx];
+        // The export worker snapshots records from its own thread; the
+        // multi-word record write has to be ordered against those reads
+        furi_mutex_acquire(instance->mutex, FuriWaitForever);
+        item->record = record;
+        item->update_tick = furi_get_tick();
+        item->last_hash = hash;
+        item->last_hash_tick = item->update_tick;
+        tpms_history_trend_push(item, &record);
+        furi_mutex_release(instance->mutex);
+        return TPMSHistoryStateAddKeyUpdateData;
+    }
 
-        do {
-            if(!flipper_format_rewind(item->flipper_string)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            if(!flipper_format_read_string(
-                   item->flipper_string, "Protocol", instance->tmp_string)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
-                break;
+    // or add new record, in ring mode evicting the stalest sensor when full
+    bool evicted = false;
+    uint16_t write_idx = instance->last_index_write;
+    if(write_idx >= TPMS_HISTORY_MAX) {
+        write_idx = 0;
+        for(uint16_t i = 1; i < TPMS_HISTORY_MAX; i++) {
+            if(instance->history->items[i].update_tick <
+               instance->history->items[write_idx].update_tick) {
+                write_idx = i;
             }
+        }
+        evicted = true;
+    }
 
-            if(!flipper_format_rewind(item->flipper_string)) {
-                FURI_LOG_E(TAG, "Rewind error");
-                break;
-            }
-            uint32_t id = 0;
-            if(!flipper_format_read_uint32(item->flipper_string, "Id", &id, 1)) {
-                FURI_LOG_E(TAG, "Missing Id");
-                break;
-            }
-            furi_string_cat_printf(instance->tmp_string, " %lX", id);
+    // A reader may be drawing this slot's menu string right now,
+    // especially the one being evicted and rewritten in place
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    TPMSHistoryItem* item = &instance->history->items[write_idx];
+    item->preset.frequency = preset->frequency;
+    furi_string_set(item->preset.name, preset->name);
+    item->preset.data = preset->data;
+    item->preset.data_size = preset->data_size;
+    item->record = record;
+    item->update_tick = furi_get_tick();
+    item->last_hash = hash;
+    item->last_hash_tick = item->update_tick;
+    item->trend_head = 0;
+    item->trend_count = 0;
+    tpms_history_trend_push(item, &record);
+
+    tpms_history_item_menu_str(instance, item);
 
-            furi_string_set(item->item_str, instance->tmp_string);
-        } while(false);
-        instance->last_index_write++;
-        return TPMSHistoryStateAddKeyNewDada;
+    if(evicted) {
+        // Old id has to leave the open-addressing index, rebuild it
+        tpms_history_index_rebuild(instance);
+        instance->generation++;
+        furi_mutex_release(instance->mutex);
+        return TPMSHistoryStateAddKeyOverwrite;
     }
-    return TPMSHistoryStateAddKeyUnknown;
+    tpms_history_index_insert(instance, record.id, write_idx);
+    instance->last_index_write++;
+    instance->generation++;
+    furi_mutex_release(instance->mutex);
+    return TPMSHistoryStateAddKeyNewDada;
 }
@@ -4,7 +4,6 @@
 #include <math.h>
 #include <furi.h>
 #include <furi_hal.h>
-#include <lib/flipper_format/flipper_format.h>
 #include <lib/subghz/types.h>
 
 typedef struct TPMSHistory TPMSHistory;
@@ -16,30 +15,84 @@ typedef enum {
     TPMSHistoryStateAddKeyNewDada,
     TPMSHistoryStateAddKeyUpdateData,
     TPMSHistoryStateAddKeyOverflow,
+    TPMSHistoryStateAddKeyOverwrite,
 } TPMSHistoryStateAddKey;
 
+/** Packed record, primary storage of a received frame */
+typedef struct {
+    uint32_t id;
+    uint8_t type;
+    uint8_t battery_low;
+    uint8_t data_count_bit;
+    uint32_t timestamp;
+    uint64_t data;
+    int32_t pressure_mb; // millibar
+    int16_t temperature_dc; // celsius * 10
+    const char* protocol_name;
+} TPMSHistoryRecord;
+
+// Per-sensor trend ring depth
+#define TPMS_HISTORY_TREND_DEPTH 12
+
+/** One trend sample in 16-bit fixed point: centibar and deci-degrees
+ *  Celsius keep the ring at eight bytes per sample */
+typedef struct {
+    uint32_t timestamp;
+    int16_t pressure_cb; // bar * 100
+    int16_t temperature_dc; // celsius * 10
+} TPMSTrendSample;
+
+/** Copy the trend ring of history[idx], oldest sample first
+ *
+ * @param instance  - TPMSHistory instance
+ * @param idx       - record index
+ * @param samples   - output array, TPMS_HISTORY_TREND_DEPTH entries
+ * @param max_count - output array capacity
+ * @return number of samples copied
+ */
+uint8_t tpms_history_get_trend(
+    TPMSHistory* instance,
+    uint16_t idx,
+    TPMSTrendSample* samples,
+    uint8_t max_count);
+
 /** Allocate TPMSHistory
- * 
- * @return TPMSHistory* 
+ *
+ * @return TPMSHistory*
  */
 TPMSHistory* tpms_history_alloc(void);
 
 /** Free TPMSHistory
- * 
+ *
  * @param instance - TPMSHistory instance
  */
 void tpms_history_free(TPMSHistory* instance);
 
 /** Clear history
- * 
+ *
  * @param instance - TPMSHistory instance
  */
 void tpms_history_reset(TPMSHistory* instance);
 
+/** Set ring-buffer mode: when full, evict the least-recently-updated
+ *  sensor instead of refusing new ones
+ *
+ * @param instance  - TPMSHistory instance
+ * @param overwrite - true to evict, false to stop on full
+ */
+void tpms_history_set_overwrite(TPMSHistory* instance, bool overwrite);
+
+/** Get ring-buffer mode
+ *
+ * @param instance - TPMSHistory instance
+ * @return bool - overwrite enabled
+ */
+bool tpms_history_get_overwrite(TPMSHistory* instance);
+
 /** Get frequency to history[idx]
- * 
+ *
  * @param instance  - TPMSHistory instance
- * @param idx       - record index  
+ * @param idx       - record index
  * @return frequency - frequency Hz
  */
 uint32_t tpms_history_get_frequency(TPMSHistory* instance, uint16_t idx);
@@ -47,38 +100,102 @@ uint32_t tpms_history_get_frequency(TPMSHistory* instance, uint16_t idx);
 SubGhzRadioPreset* tpms_history_get_radio_preset(TPMSHistory* instance, uint16_t idx);
 
 /** Get preset to history[idx]
- * 
+ *
  * @param instance  - TPMSHistory instance
- * @param idx       - record index  
+ * @param idx       - record index
  * @return preset   - preset name
  */
 const char* tpms_history_get_preset(TPMSHistory* instance, uint16_t idx);
 
-/** Get history index write 
- * 
+/** Get history index write
+ *
  * @param instance  - TPMSHistory instance
- * @return idx      - current record index  
+ * @return idx      - current record index
  */
 uint16_t tpms_history_get_item(TPMSHistory* instance);
 
+/** Get the change generation. Bumped whenever the menu list a reader
+ *  could have rendered changes: new record, in-place eviction, label
+ *  refresh or reset. Readers cache against it instead of copying
+ *
+ * @param instance  - TPMSHistory instance
+ * @return generation counter
+ */
+uint32_t tpms_history_get_generation(TPMSHistory* instance);
+
 /** Get type protocol to history[idx]
- * 
+ *
  * @param instance  - TPMSHistory instance
- * @param idx       - record index  
- * @return type      - type protocol  
+ * @param idx       - record index
+ * @return type      - type protocol
  */
 uint8_t tpms_history_get_type_protocol(TPMSHistory* instance, uint16_t idx);
 
 /** Get name protocol to history[idx]
- * 
+ *
  * @param instance  - TPMSHistory instance
- * @param idx       - record index  
- * @return name      - const char* name protocol  
+ * @param idx       - record index
+ * @return name      - const char* name protocol
  */
 const char* tpms_history_get_protocol_name(TPMSHistory* instance, uint16_t idx);
 
+/** Find record index by sensor id, O(1) via the internal id index
+ *
+ * @param instance  - TPMSHistory instance
+ * @param id        - sensor id
+ * @param idx       - output record index, may be NULL
+ * @return bool - true if found
+ */
+bool tpms_history_find_by_id(TPMSHistory* instance, uint32_t id, uint16_t* idx);
+
+/** Get packed record to history[idx]
+ *
+ * @param instance  - TPMSHistory instance
+ * @param idx       - record index
+ * @return TPMSHistoryRecord*
+ */
+const TPMSHistoryRecord* tpms_history_get_record(TPMSHistory* instance, uint16_t idx);
+
+/** Copy history[idx] and its radio preset under the history lock, for
+ *  readers on another thread while the decode path keeps updating (and
+ *  in ring mode rewriting) the same slots
+ *
+ * @param instance - TPMSHistory instance
+ * @param idx      - record index
+ * @param record   - output record copy
+ * @param preset   - output preset: frequency/data/data_size are copied,
+ *                   name is set into the caller-owned FuriString
+ */
+void tpms_history_get_record_snapshot(
+    TPMSHistory* instance,
+    uint16_t idx,
+    TPMSHistoryRecord* record,
+    SubGhzRadioPreset* preset);
+
+/** Resolver mapping a sensor id to a display label, NULL when unknown */
+typedef const char* (*TPMSHistoryLabelResolver)(void* context, uint32_t id);
+
+/** Set the label resolver consulted when menu strings are built, so
+ *  known sensors show their name instead of a raw hex id
+ *
+ * @param instance  - TPMSHistory instance
+ * @param resolver  - TPMSHistoryLabelResolver or NULL
+ * @param context   - resolver context
+ */
+void tpms_history_set_label_resolver(
+    TPMSHistory* instance,
+    TPMSHistoryLabelResolver resolver,
+    void* context);
+
+/** Rebuild the menu string of history[idx] after its label changed
+ *
+ * @param instance  - TPMSHistory instance
+ * @param idx       - record index
+ */
+void tpms_history_refresh_item_menu(TPMSHistory* instance, uint16_t idx);
+
 /** Get string item menu to history[idx]
- * 
+ *
  * @param instance  - TPMSHistory instance
  * @param output    - FuriString* output
  * @param idx       - record index
@@ -86,7 +203,7 @@ const char* tpms_history_get_protocol_name(TPMSHistory* instance, uint16_t idx);
 void tpms_history_get_text_item_menu(TPMSHistory* instance, FuriString* output, uint16_t idx);
 
 /** Get string the remaining number of records to history
- * 
+ *
  * @param instance  - TPMSHistory instance
  * @param output    - FuriString* output
  * @return bool - is FUUL
@@ -94,7 +211,7 @@ void tpms_history_get_text_item_menu(TPMSHistory* instance, FuriString* output,
 bool tpms_history_get_text_space_left(TPMSHistory* instance, FuriString* output);
 
 /** Add protocol to history
- * 
+ *
  * @param instance  - TPMSHistory instance
  * @param context    - SubGhzProtocolCommon context
  * @param preset    - SubGhzRadioPreset preset
@@ -102,11 +219,3 @@ bool tpms_history_get_text_space_left(TPMSHistory* instance, FuriString* output)
  */
 TPMSHistoryStateAddKey
     tpms_history_add_to_history(TPMSHistory* instance, void* context, SubGhzRadioPreset* preset);
-
-/** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
- * 
- * @param instance  - TPMSHistory instance
- * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
- */
-FlipperFormat* tpms_history_get_raw_data(TPMSHistory* instance, uint16_t idx);
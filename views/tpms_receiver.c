@@ -5,7 +5,6 @@
 
 #include <input/input.h>
 #include <gui/elements.h>
-#include <m-array.h>
 
 #define TAG "TPMSReceiver"
 
@@ -14,21 +13,21 @@
 #define MENU_ITEMS 4u
 #define UNLOCK_CNT 3
 
-#define SUBGHZ_RAW_THRESHOLD_MIN -90.0f
-typedef struct {
-    FuriString* item_str;
-    uint8_t type;
-} TPMSReceiverMenuItem;
-
-ARRAY_DEF(TPMSReceiverMenuItemArray, TPMSReceiverMenuItem, M_POD_OPLIST)
+// Cache slot key for "nothing rendered yet"
+#define TPMS_RECEIVER_CACHE_IDX_NONE 0xFFFF
 
-#define M_OPL_TPMSReceiverMenuItemArray_t() ARRAY_OPLIST(TPMSReceiverMenuItemArray, M_POD_OPLIST)
-
-struct TPMSReceiverHistory {
-    TPMSReceiverMenuItemArray_t data;
-};
+#define SUBGHZ_RAW_THRESHOLD_MIN -90.0f
 
-typedef struct TPMSReceiverHistory TPMSReceiverHistory;
+// Width-fitted copy of one visible menu line, rebuilt from the history
+// store only when its key no longer matches: another record in the slot,
+// a history generation bump, or the target width changing (scrollbar
+// appearing). The view owns no other copy of the list
+typedef struct {
+    uint16_t idx;
+    uint32_t generation;
+    uint8_t fitted_width;
+    FuriString* fitted_str;
+} TPMSReceiverMenuCache;
 
 // static const Icon* ReceiverItemIcons[] = {
 //     [SubGhzProtocolTypeUnknown] = &I_Quest_7x8,
@@ -48,8 +47,6 @@ struct TPMSReceiver {
     TPMSLock lock;
     uint8_t lock_count;
     FuriTimer* lock_timer;
-    FuriTimer* relearn_timer;
-    bool relearn_active;
     View* view;
     TPMSReceiverCallback callback;
     void* context;
@@ -59,28 +56,59 @@ typedef struct {
     FuriString* frequency_str;
     FuriString* preset_str;
     FuriString* history_stat_str;
-    TPMSReceiverHistory* history;
+    TPMSHistory* history; // read-only, owned by the app
+    TPMSReceiverMenuCache cache[MENU_ITEMS];
     uint16_t idx;
     uint16_t list_offset;
     uint16_t history_item;
     TPMSReceiverBarShow bar_show;
     uint8_t u_rssi;
     bool external_radio;
+    // Session export progress, drawn in the status bar while active
+    bool export_active;
+    uint16_t export_done;
+    uint16_t export_total;
 } TPMSReceiverModel;
 
 void tpms_view_receiver_set_rssi(TPMSReceiver* instance, float rssi) {
     furi_assert(instance);
+    uint8_t u_rssi;
+    if(rssi < SUBGHZ_RAW_THRESHOLD_MIN) {
+        u_rssi = 0;
+    } else {
+        u_rssi = (uint8_t)(rssi - SUBGHZ_RAW_THRESHOLD_MIN);
+    }
+    // Samples arrive continuously while scanning; only commit a redraw
+    // when the bar would actually move, so drawing stops competing with
+    // the SubGhz worker for CPU on every tick
+    bool changed = false;
     with_view_model(
         instance->view,
         TPMSReceiverModel * model,
         {
-            if(rssi < SUBGHZ_RAW_THRESHOLD_MIN) {
-                model->u_rssi = 0;
-            } else {
-                model->u_rssi = (uint8_t)(rssi - SUBGHZ_RAW_THRESHOLD_MIN);
-            }
+            changed = (model->u_rssi != u_rssi);
+            model->u_rssi = u_rssi;
         },
-        true);
+        changed);
+}
+
+void tpms_view_receiver_set_export_progress(
+    TPMSReceiver* instance,
+    bool active,
+    uint16_t done,
+    uint16_t total) {
+    furi_assert(instance);
+    bool changed = false;
+    with_view_model(
+        instance->view,
+        TPMSReceiverModel * model,
+        {
+            changed = (model->export_active != active) || (model->export_done != done);
+            model->export_active = active;
+            model->export_done = done;
+            model->export_total = total;
+        },
+        changed);
 }
 
 void tpms_view_receiver_set_lock(TPMSReceiver* tpms_receiver, TPMSLock lock) {
@@ -135,27 +163,38 @@ static void tpms_view_receiver_update_offset(TPMSReceiver* tpms_receiver) {
         true);
 }
 
-void tpms_view_receiver_add_item_to_menu(
-    TPMSReceiver* tpms_receiver,
-    const char* name,
-    uint8_t type) {
+void tpms_view_receiver_set_history(TPMSReceiver* tpms_receiver, TPMSHistory* history) {
     furi_assert(tpms_receiver);
     with_view_model(
         tpms_receiver->view,
         TPMSReceiverModel * model,
         {
-            TPMSReceiverMenuItem* item_menu =
-                TPMSReceiverMenuItemArray_push_raw(model->history->data);
-            item_menu->item_str = furi_string_alloc_set(name);
-            item_menu->type = type;
-            if((model->idx == model->history_item - 1)) {
-                model->history_item++;
-                model->idx++;
-            } else {
-                model->history_item++;
+            model->history = history;
+            model->history_item = history ? tpms_history_get_item(history) : 0;
+            model->idx = 0;
+            model->list_offset = 0;
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                model->cache[i].idx = TPMS_RECEIVER_CACHE_IDX_NONE;
             }
         },
         true);
+}
+
+void tpms_view_receiver_update(TPMSReceiver* tpms_receiver) {
+    furi_assert(tpms_receiver);
+    with_view_model(
+        tpms_receiver->view,
+        TPMSReceiverModel * model,
+        {
+            uint16_t item_count = model->history ? tpms_history_get_item(model->history) : 0;
+            // Cursor on the newest item keeps following the tail
+            if(item_count > model->history_item && model->history_item &&
+               model->idx == model->history_item - 1) {
+                model->idx = item_count - 1;
+            }
+            model->history_item = item_count;
+        },
+        true);
     tpms_view_receiver_update_offset(tpms_receiver);
 }
 
@@ -166,16 +205,21 @@ void tpms_view_receiver_add_data_statusbar(
     const char* history_stat_str,
     bool external) {
     furi_assert(tpms_receiver);
+    bool changed = false;
     with_view_model(
         tpms_receiver->view,
         TPMSReceiverModel * model,
         {
+            changed = !furi_string_equal_str(model->frequency_str, frequency_str) ||
+                      !furi_string_equal_str(model->preset_str, preset_str) ||
+                      !furi_string_equal_str(model->history_stat_str, history_stat_str) ||
+                      (model->external_radio != external);
             furi_string_set_str(model->frequency_str, frequency_str);
             furi_string_set_str(model->preset_str, preset_str);
             furi_string_set_str(model->history_stat_str, history_stat_str);
             model->external_radio = external;
         },
-        true);
+        changed);
 }
 
 static void tpms_view_receiver_draw_frame(Canvas* canvas, uint16_t idx, bool scrollbar) {
@@ -210,29 +254,36 @@ void tpms_view_receiver_draw(Canvas* canvas, TPMSReceiverModel* model) {
     elements_button_left(canvas, "Config");
 
     bool scrollbar = model->history_item > 4;
-    FuriString* str_buff;
-    str_buff = furi_string_alloc();
-
-    TPMSReceiverMenuItem* item_menu;
+    uint8_t fit_width = scrollbar ? MAX_LEN_PX - 6 : MAX_LEN_PX;
+    uint32_t generation = model->history ? tpms_history_get_generation(model->history) : 0;
 
     for(size_t i = 0; i < MIN(model->history_item, MENU_ITEMS); ++i) {
         size_t idx = CLAMP((uint16_t)(i + model->list_offset), model->history_item, 0);
-        item_menu = TPMSReceiverMenuItemArray_get(model->history->data, idx);
-        furi_string_set(str_buff, item_menu->item_str);
-        elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 6 : MAX_LEN_PX);
+        // Render straight from the history store through the per-row
+        // fitted cache; a stale key (scrolled row, generation bump,
+        // width change) rebuilds just that row
+        TPMSReceiverMenuCache* cache = &model->cache[idx % MENU_ITEMS];
+        if(cache->idx != idx || cache->generation != generation ||
+           cache->fitted_width != fit_width) {
+            tpms_history_get_text_item_menu(model->history, cache->fitted_str, idx);
+            elements_string_fit_width(canvas, cache->fitted_str, fit_width);
+            cache->idx = idx;
+            cache->generation = generation;
+            cache->fitted_width = fit_width;
+        }
         if(model->idx == idx) {
             tpms_view_receiver_draw_frame(canvas, i, scrollbar);
         } else {
             canvas_set_color(canvas, ColorBlack);
         }
-        // canvas_draw_icon(canvas, 4, 2 + i * FRAME_HEIGHT, ReceiverItemIcons[item_menu->type]);
-        canvas_draw_str(canvas, 4, 9 + i * FRAME_HEIGHT, furi_string_get_cstr(str_buff));
-        furi_string_reset(str_buff);
+        // canvas_draw_icon(
+        //     canvas, 4, 2 + i * FRAME_HEIGHT,
+        //     ReceiverItemIcons[tpms_history_get_type_protocol(model->history, idx)]);
+        canvas_draw_str(canvas, 4, 9 + i * FRAME_HEIGHT, furi_string_get_cstr(cache->fitted_str));
     }
     if(scrollbar) {
         elements_scrollbar_pos(canvas, 128, 0, 49, model->idx, model->history_item);
     }
-    furi_string_free(str_buff);
 
     canvas_set_color(canvas, ColorBlack);
 
@@ -272,8 +323,16 @@ void tpms_view_receiver_draw(Canvas* canvas, TPMSReceiverModel* model) {
         canvas_draw_str(canvas, 74, 62, "Unlocked");
         break;
     default:
-        canvas_draw_str(canvas, 44, 62, furi_string_get_cstr(model->frequency_str));
-        canvas_draw_str(canvas, 79, 62, furi_string_get_cstr(model->preset_str));
+        if(model->export_active) {
+            char export_str[20];
+            snprintf(
+                export_str, sizeof(export_str), "Save %u/%u", model->export_done,
+                model->export_total);
+            canvas_draw_str(canvas, 44, 62, export_str);
+        } else {
+            canvas_draw_str(canvas, 44, 62, furi_string_get_cstr(model->frequency_str));
+            canvas_draw_str(canvas, 79, 62, furi_string_get_cstr(model->preset_str));
+        }
         canvas_draw_str(canvas, 96, 62, furi_string_get_cstr(model->history_stat_str));
         break;
     }
@@ -296,30 +355,6 @@ static void tpms_view_receiver_lock_timer_callback(void* context) {
     tpms_receiver->lock_count = 0;
 }
 
-static void tpms_relearn_stop(void* context) {
-    furi_assert(context);
-    TPMSReceiver* tpms_receiver = context;
-    if(tpms_receiver->relearn_active) {
-        tpms_receiver->relearn_active = false;
-        furi_timer_stop(tpms_receiver->relearn_timer);
-        furi_hal_rfid_tim_read_stop();
-    }
-}
-
-static void tpms_relearn_start(void* context) {
-    furi_assert(context);
-    TPMSReceiver* tpms_receiver = context;
-    if(tpms_receiver->relearn_active) tpms_relearn_stop(context);
-    tpms_receiver->relearn_active = true;
-    furi_hal_rfid_tim_read_start(125000, 0.5);
-    furi_timer_start(tpms_receiver->relearn_timer, furi_ms_to_ticks(3000));
-}
-
-static void tpms_view_receiver_relearn_timer_callback(void* context) {
-    furi_assert(context);
-    tpms_relearn_stop(context);
-}
-
 bool tpms_view_receiver_input(InputEvent* event, void* context) {
     furi_assert(context);
     TPMSReceiver* tpms_receiver = context;
@@ -374,8 +409,21 @@ bool tpms_view_receiver_input(InputEvent* event, void* context) {
             true);
     } else if(event->key == InputKeyLeft && event->type == InputTypeShort) {
         tpms_receiver->callback(TPMSCustomEventViewReceiverConfig, tpms_receiver->context);
+    } else if(event->key == InputKeyLeft && event->type == InputTypeLong) {
+        with_view_model(
+            tpms_receiver->view,
+            TPMSReceiverModel * model,
+            {
+                if(model->history_item != 0) {
+                    tpms_receiver->callback(
+                        TPMSCustomEventViewReceiverSave, tpms_receiver->context);
+                }
+            },
+            false);
     } else if(event->key == InputKeyRight && event->type == InputTypeShort) {
-        tpms_relearn_start(tpms_receiver);
+        tpms_receiver->callback(TPMSCustomEventViewReceiverRelearn, tpms_receiver->context);
+    } else if(event->key == InputKeyRight && event->type == InputTypeLong) {
+        tpms_receiver->callback(TPMSCustomEventViewReceiverRelearnRapid, tpms_receiver->context);
     } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
         with_view_model(
             tpms_receiver->view,
@@ -386,6 +434,17 @@ bool tpms_view_receiver_input(InputEvent* event, void* context) {
                 }
             },
             false);
+    } else if(event->key == InputKeyOk && event->type == InputTypeLong) {
+        with_view_model(
+            tpms_receiver->view,
+            TPMSReceiverModel * model,
+            {
+                if(model->history_item != 0) {
+                    tpms_receiver->callback(
+                        TPMSCustomEventViewReceiverOKLong, tpms_receiver->context);
+                }
+            },
+            false);
     }
 
     tpms_view_receiver_update_offset(tpms_receiver);
@@ -407,19 +466,15 @@ void tpms_view_receiver_exit(void* context) {
             furi_string_reset(model->frequency_str);
             furi_string_reset(model->preset_str);
             furi_string_reset(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, TPMSReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                TPMSReceiverMenuItemArray_reset(model->history->data);
-                model->idx = 0;
-                model->list_offset = 0;
-                model->history_item = 0;
+            model->idx = 0;
+            model->list_offset = 0;
+            model->history_item = 0;
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                model->cache[i].idx = TPMS_RECEIVER_CACHE_IDX_NONE;
+            }
         },
         false);
     furi_timer_stop(tpms_receiver->lock_timer);
-    tpms_relearn_stop(tpms_receiver);
 }
 
 TPMSReceiver* tpms_view_receiver_alloc() {
@@ -445,15 +500,16 @@ TPMSReceiver* tpms_view_receiver_alloc() {
             model->preset_str = furi_string_alloc();
             model->history_stat_str = furi_string_alloc();
             model->bar_show = TPMSReceiverBarShowDefault;
-            model->history = malloc(sizeof(TPMSReceiverHistory));
+            model->history = NULL;
             model->external_radio = false;
-            TPMSReceiverMenuItemArray_init(model->history->data);
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                model->cache[i].idx = TPMS_RECEIVER_CACHE_IDX_NONE;
+                model->cache[i].fitted_str = furi_string_alloc();
+            }
         },
         true);
     tpms_receiver->lock_timer =
         furi_timer_alloc(tpms_view_receiver_lock_timer_callback, FuriTimerTypeOnce, tpms_receiver);
-    tpms_receiver->relearn_timer = furi_timer_alloc(
-        tpms_view_receiver_relearn_timer_callback, FuriTimerTypeOnce, tpms_receiver);
     return tpms_receiver;
 }
 
@@ -467,17 +523,12 @@ void tpms_view_receiver_free(TPMSReceiver* tpms_receiver) {
             furi_string_free(model->frequency_str);
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
-                for
-                    M_EACH(item_menu, model->history->data, TPMSReceiverMenuItemArray_t) {
-                        furi_string_free(item_menu->item_str);
-                        item_menu->type = 0;
-                    }
-                TPMSReceiverMenuItemArray_clear(model->history->data);
-                free(model->history);
+            for(size_t i = 0; i < MENU_ITEMS; i++) {
+                furi_string_free(model->cache[i].fitted_str);
+            }
         },
         false);
     furi_timer_free(tpms_receiver->lock_timer);
-    furi_timer_free(tpms_receiver->relearn_timer);
     view_free(tpms_receiver->view);
     free(tpms_receiver);
 }
@@ -3,6 +3,7 @@
 #include <gui/view.h>
 #include "../helpers/tpms_types.h"
 #include "../helpers/tpms_event.h"
+#include "../tpms_history.h"
 
 typedef struct TPMSReceiver TPMSReceiver;
 
@@ -10,6 +11,12 @@ typedef void (*TPMSReceiverCallback)(TPMSCustomEvent event, void* context);
 
 void tpms_view_receiver_set_rssi(TPMSReceiver* instance, float rssi);
 
+void tpms_view_receiver_set_export_progress(
+    TPMSReceiver* instance,
+    bool active,
+    uint16_t done,
+    uint16_t total);
+
 void tpms_view_receiver_set_lock(TPMSReceiver* tpms_receiver, TPMSLock keyboard);
 
 void tpms_view_receiver_set_callback(
@@ -30,10 +37,15 @@ void tpms_view_receiver_add_data_statusbar(
     const char* history_stat_str,
     bool external);
 
-void tpms_view_receiver_add_item_to_menu(
-    TPMSReceiver* tpms_receiver,
-    const char* name,
-    uint8_t type);
+/** Attach the history the menu renders from. The view holds the pointer
+ *  read-only and caches fitted strings against the history generation;
+ *  it never copies the list */
+void tpms_view_receiver_set_history(TPMSReceiver* tpms_receiver, TPMSHistory* history);
+
+/** Pick up a changed item count from the attached history: follows the
+ *  cursor when it sat on the newest item, refits the scroll offset and
+ *  commits a redraw */
+void tpms_view_receiver_update(TPMSReceiver* tpms_receiver);
 
 uint16_t tpms_view_receiver_get_idx_menu(TPMSReceiver* tpms_receiver);
 
@@ -13,22 +13,88 @@ struct TPMSReceiverInfo {
 
 typedef struct {
     uint32_t curr_ts;
-    FuriString* protocol_name;
-    TPMSBlockGeneric* generic;
+    uint32_t id;
+    uint32_t record_ts;
+    // Static layer, formatted once per record in set_record(). The
+    // 1-second timer redraw then only re-renders these buffers plus the
+    // age counter instead of re-formatting every field
+    char str_header[32];
+    char str_id[24];
+    char str_batt[16];
+    bool has_batt;
+    char str_temp[12];
+    uint8_t temp_x1;
+    uint8_t temp_x2;
+    char str_press[16];
+    TPMSTrendSample trend[TPMS_HISTORY_TREND_DEPTH];
+    uint8_t trend_count;
+    bool show_trend;
 } TPMSReceiverInfoModel;
 
-void tpms_view_receiver_info_update(TPMSReceiverInfo* tpms_receiver_info, FlipperFormat* fff) {
+void tpms_view_receiver_info_set_record(
+    TPMSReceiverInfo* tpms_receiver_info,
+    const TPMSHistoryRecord* record) {
     furi_assert(tpms_receiver_info);
-    furi_assert(fff);
+    furi_assert(record);
 
     with_view_model(
         tpms_receiver_info->view,
         TPMSReceiverInfoModel * model,
         {
-            flipper_format_rewind(fff);
-            flipper_format_read_string(fff, "Protocol", model->protocol_name);
+            model->id = record->id;
+            model->record_ts = record->timestamp;
+
+            snprintf(
+                model->str_header,
+                sizeof(model->str_header),
+                "%s %db",
+                record->protocol_name,
+                record->data_count_bit);
+            snprintf(model->str_id, sizeof(model->str_id), "ID: 0x%lX", record->id);
+
+            model->has_batt = (record->battery_low != TPMS_NO_BATT);
+            if(model->has_batt) {
+                snprintf(
+                    model->str_batt,
+                    sizeof(model->str_batt),
+                    "Batt: %s",
+                    (!record->battery_low ? "ok" : "low"));
+            }
 
-            tpms_block_generic_deserialize(model->generic, fff);
+            if(furi_hal_rtc_get_locale_units() == FuriHalRtcLocaleUnitsMetric) {
+                snprintf(
+                    model->str_temp,
+                    sizeof(model->str_temp),
+                    "%d C",
+                    record->temperature_dc / 10);
+                if(record->temperature_dc < -90) {
+                    model->temp_x1 = 42;
+                    model->temp_x2 = 33;
+                } else {
+                    model->temp_x1 = 40;
+                    model->temp_x2 = 30;
+                }
+            } else {
+                // Fahrenheit in deci-degrees: C * 9 / 5 + 32
+                int32_t temperature_df = (int32_t)record->temperature_dc * 9 / 5 + 320;
+                snprintf(
+                    model->str_temp,
+                    sizeof(model->str_temp),
+                    "%ld F",
+                    temperature_df / 10);
+                if((record->temperature_dc < -277) || (record->temperature_dc > 377)) {
+                    model->temp_x1 = 43;
+                    model->temp_x2 = 35;
+                } else {
+                    model->temp_x1 = 41;
+                    model->temp_x2 = 33;
+                }
+            }
+
+            char pressure_str[12];
+            tpms_format_fixed(
+                pressure_str, sizeof(pressure_str), (record->pressure_mb + 50) / 100, 10);
+            snprintf(model->str_press, sizeof(model->str_press), "%sbar", pressure_str);
 
             DateTime curr_dt;
             furi_hal_rtc_get_datetime(&curr_dt);
@@ -37,74 +103,135 @@ void tpms_view_receiver_info_update(TPMSReceiverInfo* tpms_receiver_info, Flippe
         true);
 }
 
-void tpms_view_receiver_info_draw(Canvas* canvas, TPMSReceiverInfoModel* model) {
+void tpms_view_receiver_info_set_trend(
+    TPMSReceiverInfo* tpms_receiver_info,
+    const TPMSTrendSample* samples,
+    uint8_t count) {
+    furi_assert(tpms_receiver_info);
+
+    with_view_model(
+        tpms_receiver_info->view,
+        TPMSReceiverInfoModel * model,
+        {
+            model->trend_count = MIN(count, (uint8_t)TPMS_HISTORY_TREND_DEPTH);
+            memcpy(model->trend, samples, model->trend_count * sizeof(TPMSTrendSample));
+        },
+        true);
+}
+
+static void tpms_view_receiver_info_draw_sparkline(
+    Canvas* canvas,
+    const int16_t* values,
+    uint8_t count,
+    uint8_t x,
+    uint8_t y,
+    uint8_t w,
+    uint8_t h) {
+    int16_t min = values[0];
+    int16_t max = values[0];
+    for(uint8_t i = 1; i < count; i++) {
+        if(values[i] < min) min = values[i];
+        if(values[i] > max) max = values[i];
+    }
+    int16_t span = max - min;
+    if(span == 0) span = 1; // flat trend draws as a mid line
+
+    for(uint8_t i = 1; i < count; i++) {
+        uint8_t x0 = x + (w - 1) * (i - 1) / (count - 1);
+        uint8_t x1 = x + (w - 1) * i / (count - 1);
+        uint8_t y0 = y + (h - 1) - ((values[i - 1] - min) * (h - 1)) / span;
+        uint8_t y1 = y + (h - 1) - ((values[i] - min) * (h - 1)) / span;
+        canvas_draw_line(canvas, x0, y0, x1, y1);
+    }
+}
+
+static void tpms_view_receiver_info_draw_trend(Canvas* canvas, TPMSReceiverInfoModel* model) {
     char buffer[64];
-    canvas_clear(canvas);
-    canvas_set_color(canvas, ColorBlack);
     canvas_set_font(canvas, FontSecondary);
 
+    snprintf(buffer, sizeof(buffer), "Trend 0x%lX (%u)", model->id, model->trend_count);
+    canvas_draw_str(canvas, 0, 8, buffer);
+
+    if(model->trend_count < 2) {
+        canvas_draw_str(canvas, 0, 30, "Collecting samples...");
+        canvas_draw_str(canvas, 0, 42, "OK: back to info");
+        return;
+    }
+
+    int16_t values[TPMS_HISTORY_TREND_DEPTH];
+    const TPMSTrendSample* last = &model->trend[model->trend_count - 1];
+
+    for(uint8_t i = 0; i < model->trend_count; i++) {
+        values[i] = model->trend[i].pressure_cb;
+    }
     snprintf(
         buffer,
         sizeof(buffer),
-        "%s %db",
-        furi_string_get_cstr(model->protocol_name),
-        model->generic->data_count_bit);
-    canvas_draw_str(canvas, 0, 8, buffer);
+        "%d.%02dbar",
+        last->pressure_cb / 100,
+        abs(last->pressure_cb % 100));
+    canvas_draw_str(canvas, 0, 22, buffer);
+    tpms_view_receiver_info_draw_sparkline(canvas, values, model->trend_count, 48, 12, 80, 16);
+
+    for(uint8_t i = 0; i < model->trend_count; i++) {
+        values[i] = model->trend[i].temperature_dc;
+    }
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%d.%dC",
+        last->temperature_dc / 10,
+        abs(last->temperature_dc % 10));
+    canvas_draw_str(canvas, 0, 48, buffer);
+    tpms_view_receiver_info_draw_sparkline(canvas, values, model->trend_count, 48, 38, 80, 16);
+
+    // Age of the span on screen
+    if(model->curr_ts > model->trend[0].timestamp) {
+        uint32_t age = model->curr_ts - model->trend[0].timestamp;
+        if(age >= 60) {
+            snprintf(buffer, sizeof(buffer), "%lum", age / 60);
+        } else {
+            snprintf(buffer, sizeof(buffer), "%lus", age);
+        }
+        canvas_draw_str_aligned(canvas, 127, 8, AlignRight, AlignBottom, buffer);
+    }
+}
 
-    snprintf(buffer, sizeof(buffer), "ID: 0x%lX", model->generic->id);
-    canvas_draw_str(canvas, 0, 20, buffer);
+void tpms_view_receiver_info_draw(Canvas* canvas, TPMSReceiverInfoModel* model) {
+    char buffer[64];
+    canvas_clear(canvas);
 
-    if(model->generic->battery_low != TPMS_NO_BATT) {
-        snprintf(
-            buffer, sizeof(buffer), "Batt: %s", (!model->generic->battery_low ? "ok" : "low"));
-        canvas_draw_str_aligned(canvas, 126, 17, AlignRight, AlignCenter, buffer);
+    if(model->show_trend) {
+        canvas_set_color(canvas, ColorBlack);
+        tpms_view_receiver_info_draw_trend(canvas, model);
+        return;
     }
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_font(canvas, FontSecondary);
 
-    // snprintf(buffer, sizeof(buffer), "Data: 0x%llX", model->generic->data);
-    // canvas_draw_str(canvas, 0, 32, buffer);
+    // Static layer: strings formatted once in set_record()
+    canvas_draw_str(canvas, 0, 8, model->str_header);
+    canvas_draw_str(canvas, 0, 20, model->str_id);
+
+    if(model->has_batt) {
+        canvas_draw_str_aligned(canvas, 126, 17, AlignRight, AlignCenter, model->str_batt);
+    }
 
     elements_bold_rounded_frame(canvas, 0, 38, 127, 25);
     canvas_set_font(canvas, FontPrimary);
 
     // Temperature
     canvas_draw_icon(canvas, 6, 43, &I_Therm_7x16);
-
-    uint8_t temp_x1 = 0;
-    uint8_t temp_x2 = 0;
-    if(furi_hal_rtc_get_locale_units() == FuriHalRtcLocaleUnitsMetric) {
-        snprintf(buffer, sizeof(buffer), "%2.0f C", (double)model->generic->temperature);
-        if(model->generic->temperature < -9.0f) {
-            temp_x1 = 42;
-            temp_x2 = 33;
-        } else {
-            temp_x1 = 40;
-            temp_x2 = 30;
-        }
-    } else {
-        snprintf(
-            buffer,
-            sizeof(buffer),
-            "%3.0f F",
-            (double)locale_celsius_to_fahrenheit(model->generic->temperature));
-        if((model->generic->temperature < -27.77f) || (model->generic->temperature > 37.77f)) {
-            temp_x1 = 43;
-            temp_x2 = 35;
-        } else {
-            temp_x1 = 41;
-            temp_x2 = 33;
-        }
-    }
-
-    canvas_draw_str_aligned(canvas, temp_x1, 47, AlignRight, AlignTop, buffer);
-    canvas_draw_circle(canvas, temp_x2, 46, 1);
+    canvas_draw_str_aligned(canvas, model->temp_x1, 47, AlignRight, AlignTop, model->str_temp);
+    canvas_draw_circle(canvas, model->temp_x2, 46, 1);
 
     // Pressure
     canvas_draw_icon(canvas, 46, 43, &I_Press_7x16);
-    snprintf(buffer, sizeof(buffer), "%2.1fbar", (double)model->generic->pressure);
-    canvas_draw_str(canvas, 56, 55, buffer);
+    canvas_draw_str(canvas, 56, 55, model->str_press);
 
-    if((int)model->generic->timestamp > 0 && model->curr_ts) {
-        int ts_diff = (int)model->curr_ts - (int)model->generic->timestamp;
+    // Dynamic layer: only the age counter changes between records
+    if((int)model->record_ts > 0 && model->curr_ts) {
+        int ts_diff = (int)model->curr_ts - (int)model->record_ts;
 
         canvas_draw_icon(canvas, 92, 46, &I_Timer_11x11);
 
@@ -136,12 +263,21 @@ void tpms_view_receiver_info_draw(Canvas* canvas, TPMSReceiverInfoModel* model)
 
 bool tpms_view_receiver_info_input(InputEvent* event, void* context) {
     furi_assert(context);
-    //TPMSReceiverInfo* tpms_receiver_info = context;
+    TPMSReceiverInfo* tpms_receiver_info = context;
 
     if(event->key == InputKeyBack) {
         return false;
     }
 
+    // OK flips between the info page and the trend sparklines
+    if(event->type == InputTypeShort && event->key == InputKeyOk) {
+        with_view_model(
+            tpms_receiver_info->view,
+            TPMSReceiverInfoModel * model,
+            { model->show_trend = !model->show_trend; },
+            true);
+    }
+
     return true;
 }
 
@@ -161,7 +297,7 @@ static void tpms_view_receiver_info_exit(void* context) {
     with_view_model(
         tpms_receiver_info->view,
         TPMSReceiverInfoModel * model,
-        { furi_string_reset(model->protocol_name); },
+        { model->show_trend = false; },
         false);
 }
 
@@ -194,15 +330,6 @@ TPMSReceiverInfo* tpms_view_receiver_info_alloc() {
     view_set_enter_callback(tpms_receiver_info->view, tpms_view_receiver_info_enter);
     view_set_exit_callback(tpms_receiver_info->view, tpms_view_receiver_info_exit);
 
-    with_view_model(
-        tpms_receiver_info->view,
-        TPMSReceiverInfoModel * model,
-        {
-            model->generic = malloc(sizeof(TPMSBlockGeneric));
-            model->protocol_name = furi_string_alloc();
-        },
-        true);
-
     tpms_receiver_info->timer =
         furi_timer_alloc(tpms_view_receiver_info_timer, FuriTimerTypePeriodic, tpms_receiver_info);
 
@@ -214,15 +341,6 @@ void tpms_view_receiver_info_free(TPMSReceiverInfo* tpms_receiver_info) {
 
     furi_timer_free(tpms_receiver_info->timer);
 
-    with_view_model(
-        tpms_receiver_info->view,
-        TPMSReceiverInfoModel * model,
-        {
-            furi_string_free(model->protocol_name);
-            free(model->generic);
-        },
-        false);
-
     view_free(tpms_receiver_info->view);
     free(tpms_receiver_info);
 }
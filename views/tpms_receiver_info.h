@@ -3,11 +3,32 @@
 #include <gui/view.h>
 #include "../helpers/tpms_types.h"
 #include "../helpers/tpms_event.h"
-#include <lib/flipper_format/flipper_format.h>
+#include "../tpms_history.h"
 
 typedef struct TPMSReceiverInfo TPMSReceiverInfo;
 
-void tpms_view_receiver_info_update(TPMSReceiverInfo* tpms_receiver_info, FlipperFormat* fff);
+/** Bind the view to a history record. The static layer (protocol, id,
+ *  battery, temperature, pressure) is formatted once here; the draw
+ *  callback only renders cached strings plus the age counter
+ *
+ * @param tpms_receiver_info - TPMSReceiverInfo instance
+ * @param record - packed history record
+ */
+void tpms_view_receiver_info_set_record(
+    TPMSReceiverInfo* tpms_receiver_info,
+    const TPMSHistoryRecord* record);
+
+/** Hand the sensor's trend ring to the view, shown on the sparkline page
+ *  toggled with OK
+ *
+ * @param tpms_receiver_info - TPMSReceiverInfo instance
+ * @param samples - trend samples, oldest first
+ * @param count - sample count
+ */
+void tpms_view_receiver_info_set_trend(
+    TPMSReceiverInfo* tpms_receiver_info,
+    const TPMSTrendSample* samples,
+    uint8_t count);
 
 TPMSReceiverInfo* tpms_view_receiver_info_alloc();
 
@@ -0,0 +1,156 @@
+#include "tpms_sweep.h"
+#include "../tpms_app_i.h"
+
+#include <input/input.h>
+#include <gui/elements.h>
+
+#define TAG "TPMSSweep"
+
+// Spectrum plot area: bars grow up from the baseline, the status line
+// with the peak readout sits below it
+#define SWEEP_BASELINE_Y 52
+#define SWEEP_BAR_MAX 48
+
+struct TPMSSweep {
+    View* view;
+    TPMSSweepCallback callback;
+    void* context;
+};
+
+typedef struct {
+    uint8_t levels[TPMS_SWEEP_MAX_POINTS];
+    uint8_t peaks[TPMS_SWEEP_MAX_POINTS];
+    uint16_t count;
+    uint16_t cursor;
+    uint32_t peak_frequency;
+    float peak_rssi;
+} TPMSSweepModel;
+
+void tpms_view_sweep_set_callback(TPMSSweep* instance, TPMSSweepCallback callback, void* context) {
+    furi_assert(instance);
+    furi_assert(callback);
+    instance->callback = callback;
+    instance->context = context;
+}
+
+void tpms_view_sweep_set_levels(
+    TPMSSweep* instance,
+    const uint8_t* levels,
+    uint16_t count,
+    uint16_t cursor,
+    uint32_t peak_frequency,
+    float peak_rssi) {
+    furi_assert(instance);
+    furi_assert(count <= TPMS_SWEEP_MAX_POINTS);
+    with_view_model(
+        instance->view,
+        TPMSSweepModel * model,
+        {
+            for(uint16_t i = 0; i < count; i++) {
+                model->levels[i] = levels[i];
+                if(levels[i] > model->peaks[i]) model->peaks[i] = levels[i];
+            }
+            model->count = count;
+            model->cursor = cursor;
+            model->peak_frequency = peak_frequency;
+            model->peak_rssi = peak_rssi;
+        },
+        true);
+}
+
+static void tpms_view_sweep_draw(Canvas* canvas, TPMSSweepModel* model) {
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_set_font(canvas, FontSecondary);
+
+    if(!model->count) {
+        canvas_set_font(canvas, FontPrimary);
+        canvas_draw_str(canvas, 34, 32, "Sweeping...");
+        return;
+    }
+
+    uint8_t bar_width = 128 / model->count;
+    if(!bar_width) bar_width = 1;
+    uint8_t x0 = (128 - bar_width * model->count) / 2;
+
+    for(uint16_t i = 0; i < model->count; i++) {
+        uint8_t x = x0 + i * bar_width;
+        uint8_t level = MIN(model->levels[i], (uint8_t)SWEEP_BAR_MAX);
+        uint8_t peak = MIN(model->peaks[i], (uint8_t)SWEEP_BAR_MAX);
+        if(level) {
+            canvas_draw_box(
+                canvas, x, SWEEP_BASELINE_Y - level, bar_width > 1 ? bar_width - 1 : 1, level);
+        }
+        // Peak-hold tick above the live bar
+        if(peak > level) {
+            canvas_draw_line(
+                canvas,
+                x,
+                SWEEP_BASELINE_Y - peak,
+                x + (bar_width > 1 ? bar_width - 2 : 0),
+                SWEEP_BASELINE_Y - peak);
+        }
+        if(i == model->cursor) {
+            canvas_draw_dot(canvas, x + bar_width / 2, SWEEP_BASELINE_Y + 2);
+        }
+    }
+    canvas_draw_line(canvas, 0, SWEEP_BASELINE_Y, 127, SWEEP_BASELINE_Y);
+
+    if(model->peak_frequency) {
+        char peak_str[36];
+        snprintf(
+            peak_str,
+            sizeof(peak_str),
+            "Peak %lu.%02lu MHz %d dBm",
+            model->peak_frequency / 1000000,
+            (model->peak_frequency % 1000000) / 10000,
+            (int)model->peak_rssi);
+        canvas_draw_str(canvas, 2, 62, peak_str);
+    } else {
+        canvas_draw_str(canvas, 2, 62, "OK to clear peaks");
+    }
+}
+
+static bool tpms_view_sweep_input(InputEvent* event, void* context) {
+    furi_assert(context);
+    TPMSSweep* instance = context;
+
+    if(event->key == InputKeyBack && event->type == InputTypeShort) {
+        instance->callback(TPMSCustomEventViewSweepBack, instance->context);
+    } else if(event->key == InputKeyOk && event->type == InputTypeShort) {
+        with_view_model(
+            instance->view,
+            TPMSSweepModel * model,
+            {
+                memset(model->peaks, 0, sizeof(model->peaks));
+                model->peak_frequency = 0;
+                model->peak_rssi = 0;
+            },
+            true);
+        // The scene owns the running peak, reset it there as well
+        instance->callback(TPMSCustomEventViewSweepResetPeaks, instance->context);
+    }
+    return true;
+}
+
+TPMSSweep* tpms_view_sweep_alloc(void) {
+    TPMSSweep* instance = malloc(sizeof(TPMSSweep));
+
+    instance->view = view_alloc();
+    view_allocate_model(instance->view, ViewModelTypeLocking, sizeof(TPMSSweepModel));
+    view_set_context(instance->view, instance);
+    view_set_draw_callback(instance->view, (ViewDrawCallback)tpms_view_sweep_draw);
+    view_set_input_callback(instance->view, tpms_view_sweep_input);
+    return instance;
+}
+
+void tpms_view_sweep_free(TPMSSweep* instance) {
+    furi_assert(instance);
+    view_free(instance->view);
+    free(instance);
+}
+
+View* tpms_view_sweep_get_view(TPMSSweep* instance) {
+    furi_assert(instance);
+    return instance->view;
+}
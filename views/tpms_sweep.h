@@ -0,0 +1,38 @@
+#pragma once
+
+#include <gui/view.h>
+#include "../helpers/tpms_types.h"
+#include "../helpers/tpms_event.h"
+
+typedef struct TPMSSweep TPMSSweep;
+
+typedef void (*TPMSSweepCallback)(TPMSCustomEvent event, void* context);
+
+// Upper bound on spectrum bins, hopper table plus both fine windows
+#define TPMS_SWEEP_MAX_POINTS 64
+
+TPMSSweep* tpms_view_sweep_alloc(void);
+
+void tpms_view_sweep_free(TPMSSweep* instance);
+
+View* tpms_view_sweep_get_view(TPMSSweep* instance);
+
+void tpms_view_sweep_set_callback(TPMSSweep* instance, TPMSSweepCallback callback, void* context);
+
+/** Push a whole sweep column set. Levels are 0..48 pixel bar heights;
+ *  peak-hold marks are kept inside the view until OK clears them
+ *
+ * @param instance - TPMSSweep instance
+ * @param levels - bar heights, one per bin
+ * @param count - bins in this sweep
+ * @param cursor - bin the sweep is currently dwelling on
+ * @param peak_frequency - strongest frequency seen so far, Hz
+ * @param peak_rssi - strongest RSSI seen so far, dBm
+ */
+void tpms_view_sweep_set_levels(
+    TPMSSweep* instance,
+    const uint8_t* levels,
+    uint16_t count,
+    uint16_t cursor,
+    uint32_t peak_frequency,
+    float peak_rssi);